@@ -6,6 +6,31 @@
 // License: BSL-1.0
 // https://github.com/yurablok/cpp-json-without-dom
 // History:
+// v0.36 2026-Oct-16    Numbers, strings and separators are read in one step of the reader loops.
+// v0.35 2026-Oct-16    Compile-time reader policies with basic_json_reader<policy_t>.
+// v0.34 2026-Oct-16    Added json_reader::stop() to end parsing from handlers.
+// v0.33 2026-Oct-16    Added json_events() coroutine generator of parsing events.
+// v0.32 2026-Oct-16    Added json_cursor for pull parsing.
+// v0.31 2026-Oct-16    Added json_paths for extracting values by JSON Pointers with wildcards.
+// v0.30 2026-Oct-16    Added json_keys for key dispatch without string comparisons in handlers.
+// v0.29 2026-Oct-16    Two-stage parsing with json_reader::structuralIndex.
+// v0.28 2026-Oct-16    Added json_parallel_reader::parse_array() for huge root arrays.
+// v0.27 2026-Oct-16    Added json_parallel_reader for JSON Lines on several threads.
+// v0.26 2026-Oct-16    Added json_reader::next_document() for JSON Lines.
+// v0.25 2026-Oct-16    Added json_file with memory-mapped input.
+// v0.24 2026-Oct-16    Added json_push_reader for documents that arrive in chunks.
+// v0.23 2026-Oct-16    Added json_reader::assign_mutable() for in-place unescaping.
+// v0.22 2026-Oct-16    Full escape decoding with `\uXXXX` in json_reader.
+// v0.21 2026-Oct-16    Reusable scratch arena for unescaped strings in json_reader.
+// v0.20 2026-Oct-16    SWAR digit parsing in json_reader.
+// v0.19 2026-Oct-16    Built-in correctly rounded float parsing in json_reader.
+// v0.18 2026-Oct-16    Lazy number conversion with raw tokens in json_reader.
+// v0.17 2026-Oct-16    Exact `int64_t` and `uint64_t` integers in json_reader.
+// v0.16 2026-Oct-16    Added json_reader::skip() with SIMD subtree skipping.
+// v0.15 2026-Oct-16    SIMD whitespace skipping in json_reader.
+// v0.14 2026-Oct-16    SIMD string scanning in json_reader.
+// v0.13 2026-Oct-16    Template handlers for json_writer without `std::function`.
+// v0.12 2026-Oct-16    Template handlers for json_reader::parse without `std::function`.
 // v0.11 2024-Jul-19    Escape only `\n` and `\r` in comments.
 // v0.10 2024-May-20    Fixed `&` operator precedence.
 // v0.9 2023-Nov-27     Added `sameLine` flag for json_writer.
@@ -20,9 +45,14 @@
 
 #pragma once
 #include <string>
+#include <vector>
+#include <deque>
 #include <functional>
+#include <algorithm>
 #include <type_traits>
 #include <cmath>
+#include <cfloat>
+#include <cstdint>
 
 #if defined(_MSVC_LANG) && _MSVC_LANG >= 201703L
 #   define CJWD_CPP_LIB_CHARCONV
@@ -98,528 +128,5823 @@ namespace std {
 #endif
 
 
-struct json_reader {
+#if !defined(CJWD_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define CJWD_SIMD_X86
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       include <intrin.h>
+#       define CJWD_TARGET(isa)
+#   else
+#       include <immintrin.h>
+#       define CJWD_TARGET(isa) __attribute__((target(isa)))
+#   endif
+#endif
+#include <cstring>
+
+// Memory mapping of json_file and json_parallel_reader are opt-in, they pull
+// in system and thread headers: `#define CJWD_MMAP` and `#define CJWD_THREADS`.
+#if !defined(CJWD_MMAP) && !defined(CJWD_NO_MMAP)
+#   define CJWD_NO_MMAP
+#endif
+#if !defined(CJWD_THREADS) && !defined(CJWD_NO_THREADS)
+#   define CJWD_NO_THREADS
+#endif
+#if !defined(CJWD_NO_MMAP)
+#   if defined(_WIN32)
+#       if !defined(NOMINMAX)
+#           define NOMINMAX
+#           define CJWD_UNDEF_NOMINMAX
+#       endif
+#       if !defined(WIN32_LEAN_AND_MEAN)
+#           define WIN32_LEAN_AND_MEAN
+#           define CJWD_UNDEF_WIN32_LEAN_AND_MEAN
+#       endif
+#       include <windows.h>
+#       if defined(CJWD_UNDEF_NOMINMAX)
+#           undef NOMINMAX
+#           undef CJWD_UNDEF_NOMINMAX
+#       endif
+#       if defined(CJWD_UNDEF_WIN32_LEAN_AND_MEAN)
+#           undef WIN32_LEAN_AND_MEAN
+#           undef CJWD_UNDEF_WIN32_LEAN_AND_MEAN
+#       endif
+#   elif defined(__unix__) || defined(__APPLE__)
+#       include <fcntl.h>
+#       include <sys/mman.h>
+#       include <sys/stat.h>
+#       include <unistd.h>
+#   else
+#       define CJWD_NO_MMAP
+#   endif
+#endif
+#if defined(CJWD_NO_MMAP)
+#   include <cstdio>
+#endif
+#if !defined(CJWD_NO_THREADS)
+#   include <thread>
+#   include <mutex>
+#   include <atomic>
+#   include <condition_variable>
+#endif
+#if !defined(CJWD_NO_COROUTINES) && defined(__cpp_impl_coroutine) && defined(__has_include)
+#   if __has_include(<coroutine>)
+#       include <coroutine>
+#       include <exception>
+#       define CJWD_COROUTINES
+#   endif
+#endif
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+#   define CJWD_CONSTEXPR14 constexpr
+#else
+#   define CJWD_CONSTEXPR14
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#   define CJWD_FORCE_INLINE __forceinline
+#   define CJWD_NOINLINE __declspec(noinline)
+#else
+#   define CJWD_FORCE_INLINE inline __attribute__((always_inline))
+#   define CJWD_NOINLINE __attribute__((noinline))
+#endif
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+#   define CJWD_STRING_TEMPLATE_ARGS // parse<"key", ...>()
+#endif
+
+namespace cjwd_detail {
+
+inline uint32_t ctz(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+#   if defined(_M_X64) || defined(_M_ARM64)
+    _BitScanForward64(&index, mask);
+#   else
+    if (!_BitScanForward(&index, static_cast<uint32_t>(mask))) {
+        _BitScanForward(&index, static_cast<uint32_t>(mask >> 32));
+        index += 32;
+    }
+#   endif
+    return index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+inline uint32_t popcount(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    mask = mask - ((mask >> 1) & 0x5555555555555555ull);
+    mask = (mask & 0x3333333333333333ull) + ((mask >> 2) & 0x3333333333333333ull);
+    mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<uint32_t>((mask * 0x0101010101010101ull) >> 56);
+#else
+    return __builtin_popcountll(mask);
+#endif
+}
+inline uint32_t clz(const uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+#   if defined(_M_X64) || defined(_M_ARM64)
+    _BitScanReverse64(&index, mask);
+#   else
+    if (_BitScanReverse(&index, static_cast<uint32_t>(mask >> 32))) {
+        index += 32;
+    }
+    else {
+        _BitScanReverse(&index, static_cast<uint32_t>(mask));
+    }
+#   endif
+    return 63 - index;
+#else
+    return __builtin_clzll(mask);
+#endif
+}
+
+// SWAR: a byte of `word` is zero
+inline uint64_t has_zero(const uint64_t word) {
+    return (word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull;
+}
+inline uint64_t load64(const char* ptr) {
+    uint64_t word;
+    std::memcpy(&word, ptr, sizeof(word));
+    return word;
+}
+
+// Returns the first `"` or `\` in [begin, end), or `end`.
+inline const char* find_quote_or_escape_swar(const char* begin, const char* end) {
+    for (; end - begin >= 8; begin += 8) {
+        const uint64_t word = load64(begin);
+        if (has_zero(word ^ 0x2222222222222222ull) | has_zero(word ^ 0x5C5C5C5C5C5C5C5Cull)) {
+            break;
+        }
+    }
+    for (; begin < end; ++begin) {
+        if ((*begin == '"') | (*begin == '\\')) {
+            break;
+        }
+    }
+    return begin;
+}
+
+#if defined(CJWD_SIMD_X86)
+inline uint32_t quote_or_escape_sse2(const char* ptr) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+        _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))
+    )));
+}
+inline const char* find_quote_or_escape_sse2(const char* begin, const char* end) {
+    for (; end - begin >= 16; begin += 16) {
+        const uint32_t mask = quote_or_escape_sse2(begin);
+        if (mask != 0) {
+            return begin + ctz(mask);
+        }
+    }
+    return find_quote_or_escape_swar(begin, end);
+}
+CJWD_TARGET("avx2")
+inline const char* find_quote_or_escape_avx2(const char* begin, const char* end) {
+    for (; end - begin >= 32; begin += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')),
+            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))
+        )));
+        if (mask != 0) {
+            return begin + ctz(mask);
+        }
+    }
+    return find_quote_or_escape_sse2(begin, end);
+}
+CJWD_TARGET("avx512f,avx512bw")
+inline const char* find_quote_or_escape_avx512(const char* begin, const char* end) {
+    for (; end - begin >= 64; begin += 64) {
+        const __m512i chunk = _mm512_loadu_si512(begin);
+        const uint64_t mask =
+            _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('"')) |
+            _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\\'));
+        if (mask != 0) {
+            return begin + ctz(mask);
+        }
+    }
+    return find_quote_or_escape_avx2(begin, end);
+}
+
+enum class isa : uint8_t {
+    sse2,
+    avx2,
+    avx512,
+};
+inline isa detect_isa() {
+#   if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return isa::sse2;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave | !avx) {
+        return isa::sse2;
+    }
+    const uint64_t xcr0 = _xgetbv(0);
+    if ((xcr0 & 0x06) != 0x06) {
+        return isa::sse2;
+    }
+    __cpuidex(info, 7, 0);
+    if ((info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (xcr0 & 0xE0) == 0xE0) {
+        return isa::avx512;
+    }
+    if (info[1] & (1 << 5)) {
+        return isa::avx2;
+    }
+    return isa::sse2;
+#   else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return isa::avx2;
+    }
+    return isa::sse2;
+#   endif
+}
+inline isa cpu_isa() {
+    static const isa level = detect_isa();
+    return level;
+}
+#endif // CJWD_SIMD_X86
+
+inline bool is_whitespace(const char c) {
+    return (c == ' ') | (c == '\n') | (c == '\r') | (c == '\t');
+}
+// Whitespace, brackets, `,`, `:`, `"` and `/` end a number or a literal.
+inline bool is_token_end(const char c) {
+    const uint64_t ends = (1ull << ' ') | (1ull << '\t') | (1ull << '\n') | (1ull << '\r') |
+        (1ull << ',') | (1ull << ':') | (1ull << '"') | (1ull << '/');
+    const uint8_t byte = static_cast<uint8_t>(c);
+    if (byte < 64) {
+        return ((ends >> byte) & 1) != 0;
+    }
+    return ((byte | 0x20) == '{') | ((byte | 0x20) == '}'); // also `[` and `]`
+}
+// SWAR: 0x80 in every byte of `word` equal to the byte of `pattern`, exact
+inline uint64_t equal_bytes(const uint64_t word, const uint64_t pattern) {
+    const uint64_t diff = word ^ pattern;
+    return ~(((diff & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full) | diff) & 0x8080808080808080ull;
+}
+
+// Returns the first byte in [begin, end) that is not whitespace, or `end`.
+inline const char* skip_whitespace(const char* begin, const char* end) {
+    if ((begin == end) || !is_whitespace(*begin)) {
+        return begin;
+    }
+#if defined(CJWD_SIMD_X86)
+    for (; end - begin >= 16; begin += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))),
+            _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')),
+                _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')))
+        ))) & 0xFFFF;
+        if (mask != 0) {
+            return begin + ctz(mask);
+        }
+    }
+#endif
+    for (; end - begin >= 8; begin += 8) {
+        const uint64_t word = load64(begin);
+        const uint64_t spaces =
+            equal_bytes(word, 0x2020202020202020ull) | equal_bytes(word, 0x0A0A0A0A0A0A0A0Aull) |
+            equal_bytes(word, 0x0D0D0D0D0D0D0D0Dull) | equal_bytes(word, 0x0909090909090909ull);
+        if (spaces != 0x8080808080808080ull) {
+            break;
+        }
+    }
+    for (; begin < end; ++begin) {
+        if (!is_whitespace(*begin)) {
+            break;
+        }
+    }
+    return begin;
+}
+
+// Returns the first `"` or `\` in [begin, end), or `end`.
+// The first 16 bytes are checked inline, longer strings go to the widest
+// instruction set available at runtime.
+inline const char* find_quote_or_escape(const char* begin, const char* end) {
+#if defined(CJWD_SIMD_X86)
+    if (end - begin < 16) {
+        return find_quote_or_escape_swar(begin, end);
+    }
+    const uint32_t mask = quote_or_escape_sse2(begin);
+    if (mask != 0) {
+        return begin + ctz(mask);
+    }
+    begin += 16;
+    switch (cpu_isa()) {
+    case isa::avx512:
+        return find_quote_or_escape_avx512(begin, end);
+    case isa::avx2:
+        return find_quote_or_escape_avx2(begin, end);
+    default:
+        return find_quote_or_escape_sse2(begin, end);
+    }
+#else
+    return find_quote_or_escape_swar(begin, end);
+#endif
+}
+// find_quote_or_escape() with the first 16 bytes checked inline, for the
+// loops of the caller.
+CJWD_FORCE_INLINE const char* find_quote_or_escape_inline(const char* begin, const char* end) {
+#if defined(CJWD_SIMD_X86)
+    if (end - begin >= 16) {
+        const uint32_t mask = quote_or_escape_sse2(begin);
+        if (mask != 0) {
+            return begin + ctz(mask);
+        }
+        return find_quote_or_escape(begin + 16, end);
+    }
+#endif
+    return find_quote_or_escape(begin, end);
+}
+
+
+// State of the subtree skipper between blocks and calls.
+struct skip_state {
+    uint64_t depth = 1;
+    bool isString = false;
+    bool isEscape = false;
+    bool isComment = false;
+};
+
+// Returns the bracket that closes the container or `limit` if it is not
+// reached. Only strings, escapes, comments and bracket depth are tracked.
+inline const char* skip_scalar(const char* begin, const char* limit, skip_state& state) {
+    for (; begin < limit; ++begin) {
+        if (state.isString) {
+            if (state.isEscape) {
+                state.isEscape = false;
+                continue;
+            }
+            begin = find_quote_or_escape(begin, limit);
+            if (begin == limit) {
+                break;
+            }
+            if (*begin == '"') {
+                state.isString = false;
+            }
+            else {
+                state.isEscape = true;
+            }
+            continue;
+        }
+        if (state.isComment) {
+            if ((*begin == '\n') | (*begin == '\r')) {
+                state.isComment = false;
+            }
+            continue;
+        }
+        switch (*begin) {
+        case '"':
+            state.isString = true;
+            break;
+        case '/':
+            state.isComment = true;
+            break;
+        case '{': case '[':
+            ++state.depth;
+            break;
+        case '}': case ']':
+            if (--state.depth == 0) {
+                return begin;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return limit;
+}
+
+// Bitmaps of a 64-byte block, bit N is byte N.
+struct block_t {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t open;
+    uint64_t close;
+    uint64_t slash;
+    uint64_t comma;
+    uint64_t colon; // the rest are only for the structural index
+    uint64_t space;
+};
+
+// Each bit set in `mask` toggles all the following bits.
+inline uint64_t prefix_xor(uint64_t mask) {
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+// Characters escaped by an odd sequence of backslashes.
+// `isEscape` carries an escape over the block boundary.
+inline uint64_t escaped_bits(uint64_t backslash, bool& isEscape) {
+    const uint64_t prevEscaped = isEscape ? 1 : 0;
+    backslash &= ~prevEscaped;
+    const uint64_t followsEscape = (backslash << 1) | prevEscaped;
+    const uint64_t evenBits = 0x5555555555555555ull;
+    const uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+    const uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+    isEscape = sequencesStartingOnEvenBits < oddSequenceStarts;
+    const uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+    return (evenBits ^ invertMask) & followsEscape;
+}
+// Bytes inside strings including the opening quote.
+inline uint64_t string_bits(const block_t& block, bool& isString, bool& isEscape) {
+    const uint64_t quote = block.quote & ~escaped_bits(block.backslash, isEscape);
+    const uint64_t inString = prefix_xor(quote) ^ (isString ? ~0ull : 0ull);
+    isString = (inString >> 63) != 0;
+    return inString;
+}
+
+// Returns the closing bracket within the block or `begin + 64`.
+inline const char* skip_block(const block_t& block, const char* begin, skip_state& state) {
+    const skip_state before = state;
+    const uint64_t inString = string_bits(block, state.isString, state.isEscape);
+    if ((block.slash & ~inString) != 0) {
+        state = before;
+        return skip_scalar(begin, begin + 64, state);
+    }
+    state.isEscape &= state.isString;
+    const uint64_t open = block.open & ~inString;
+    uint64_t close = block.close & ~inString;
+    if (popcount(close) >= state.depth) {
+        uint64_t brackets = open | close;
+        while (brackets != 0) {
+            const uint32_t index = ctz(brackets);
+            if ((open >> index) & 1) {
+                ++state.depth;
+            }
+            else if (--state.depth == 0) {
+                return begin + index;
+            }
+            brackets &= brackets - 1;
+        }
+        return begin + 64;
+    }
+    state.depth += popcount(open);
+    state.depth -= popcount(close);
+    return begin + 64;
+}
+
+#if defined(CJWD_SIMD_X86)
+inline uint64_t movemask_sse2(const __m128i (&chunks)[4], const char c) {
+    const __m128i pattern = _mm_set1_epi8(c);
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[0], pattern))))
+        | static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[1], pattern)))) << 16
+        | static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[2], pattern)))) << 32
+        | static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[3], pattern)))) << 48;
+}
+inline void classify_sse2(const char* begin, block_t& block) {
+    __m128i chunks[4];
+    __m128i lower[4]; // `[` and `]` become `{` and `}`
+    for (uint32_t i = 0; i < 4; ++i) {
+        chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i * 16));
+        lower[i] = _mm_or_si128(chunks[i], _mm_set1_epi8(0x20));
+    }
+    block.quote = movemask_sse2(chunks, '"');
+    block.backslash = movemask_sse2(chunks, '\\');
+    block.slash = movemask_sse2(chunks, '/');
+    block.comma = movemask_sse2(chunks, ',');
+    block.open = movemask_sse2(lower, '{');
+    block.close = movemask_sse2(lower, '}');
+}
+CJWD_TARGET("avx2")
+inline uint64_t movemask_avx2(const __m256i (&chunks)[2], const char c) {
+    const __m256i pattern = _mm256_set1_epi8(c);
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunks[0], pattern))))
+        | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunks[1], pattern)))) << 32;
+}
+CJWD_TARGET("avx2")
+inline void classify_avx2(const char* begin, block_t& block) {
+    __m256i chunks[2];
+    __m256i lower[2];
+    for (uint32_t i = 0; i < 2; ++i) {
+        chunks[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i * 32));
+        lower[i] = _mm256_or_si256(chunks[i], _mm256_set1_epi8(0x20));
+    }
+    block.quote = movemask_avx2(chunks, '"');
+    block.backslash = movemask_avx2(chunks, '\\');
+    block.slash = movemask_avx2(chunks, '/');
+    block.comma = movemask_avx2(chunks, ',');
+    block.open = movemask_avx2(lower, '{');
+    block.close = movemask_avx2(lower, '}');
+}
+CJWD_TARGET("avx512f,avx512bw")
+inline void classify_avx512(const char* begin, block_t& block) {
+    const __m512i chunk = _mm512_loadu_si512(begin);
+    const __m512i lower = _mm512_or_si512(chunk, _mm512_set1_epi8(0x20));
+    block.quote = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('"'));
+    block.backslash = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\\'));
+    block.slash = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('/'));
+    block.comma = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(','));
+    block.open = _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('{'));
+    block.close = _mm512_cmpeq_epi8_mask(lower, _mm512_set1_epi8('}'));
+}
+
+inline const char* skip_blocks_sse2(const char* begin, const char* end, skip_state& state) {
+    while (end - begin >= 64) {
+        const char* found = nullptr;
+        if (state.isComment) {
+            found = skip_scalar(begin, begin + 64, state);
+        }
+        else {
+            block_t block;
+            classify_sse2(begin, block);
+            found = skip_block(block, begin, state);
+        }
+        if (found != begin + 64) {
+            return found;
+        }
+        begin += 64;
+    }
+    return skip_scalar(begin, end, state);
+}
+CJWD_TARGET("avx2")
+inline const char* skip_blocks_avx2(const char* begin, const char* end, skip_state& state) {
+    while (end - begin >= 64) {
+        const char* found = nullptr;
+        if (state.isComment) {
+            found = skip_scalar(begin, begin + 64, state);
+        }
+        else {
+            block_t block;
+            classify_avx2(begin, block);
+            found = skip_block(block, begin, state);
+        }
+        if (found != begin + 64) {
+            return found;
+        }
+        begin += 64;
+    }
+    return skip_scalar(begin, end, state);
+}
+CJWD_TARGET("avx512f,avx512bw")
+inline const char* skip_blocks_avx512(const char* begin, const char* end, skip_state& state) {
+    while (end - begin >= 64) {
+        const char* found = nullptr;
+        if (state.isComment) {
+            found = skip_scalar(begin, begin + 64, state);
+        }
+        else {
+            block_t block;
+            classify_avx512(begin, block);
+            found = skip_block(block, begin, state);
+        }
+        if (found != begin + 64) {
+            return found;
+        }
+        begin += 64;
+    }
+    return skip_scalar(begin, end, state);
+}
+#endif // CJWD_SIMD_X86
+
+// Returns the bracket that closes the container opened before `begin`,
+// or `end`. The content is not validated.
+inline const char* skip_container(const char* begin, const char* end, skip_state& state) {
+#if defined(CJWD_SIMD_X86)
+    if (end - begin >= 64) {
+        switch (cpu_isa()) {
+        case isa::avx512:
+            return skip_blocks_avx512(begin, end, state);
+        case isa::avx2:
+            return skip_blocks_avx2(begin, end, state);
+        default:
+            return skip_blocks_sse2(begin, end, state);
+        }
+    }
+#endif
+    return skip_scalar(begin, end, state);
+}
+
+// Finds the elements of a container like skip_scalar: counts the commas at
+// depth 1 in `commas` and returns the closing bracket, the first comma at
+// depth 1 if `isToComma`, or `limit`.
+inline const char* index_scalar(const char* begin, const char* limit, skip_state& state,
+        uint64_t& commas, const bool isToComma) {
+    for (; begin < limit; ++begin) {
+        if (state.isString) {
+            if (state.isEscape) {
+                state.isEscape = false;
+                continue;
+            }
+            begin = find_quote_or_escape(begin, limit);
+            if (begin == limit) {
+                break;
+            }
+            if (*begin == '"') {
+                state.isString = false;
+            }
+            else {
+                state.isEscape = true;
+            }
+            continue;
+        }
+        if (state.isComment) {
+            if ((*begin == '\n') | (*begin == '\r')) {
+                state.isComment = false;
+            }
+            continue;
+        }
+        switch (*begin) {
+        case ',':
+            if (state.depth == 1) {
+                ++commas;
+                if (isToComma) {
+                    return begin;
+                }
+            }
+            break;
+        case '"':
+            state.isString = true;
+            break;
+        case '/':
+            state.isComment = true;
+            break;
+        case '{': case '[':
+            ++state.depth;
+            break;
+        case '}': case ']':
+            if (--state.depth == 0) {
+                return begin;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return limit;
+}
+// Returns the result of index_scalar within the block or `begin + 64`.
+inline const char* index_block(const block_t& block, const char* begin, skip_state& state,
+        uint64_t& commas, const bool isToComma) {
+    const skip_state before = state;
+    const uint64_t inString = string_bits(block, state.isString, state.isEscape);
+    if ((block.slash & ~inString) != 0) {
+        state = before;
+        return index_scalar(begin, begin + 64, state, commas, isToComma);
+    }
+    state.isEscape &= state.isString;
+    const uint64_t open = block.open & ~inString;
+    const uint64_t close = block.close & ~inString;
+    const uint64_t comma = block.comma & ~inString;
+    if ((comma == 0) & (popcount(close) < state.depth)) {
+        state.depth += popcount(open);
+        state.depth -= popcount(close);
+        return begin + 64;
+    }
+    uint64_t structurals = open | close | comma;
+    while (structurals != 0) {
+        const uint32_t index = ctz(structurals);
+        const uint64_t bit = 1ull << index;
+        if (open & bit) {
+            ++state.depth;
+        }
+        else if (close & bit) {
+            if (--state.depth == 0) {
+                return begin + index;
+            }
+        }
+        else if (state.depth == 1) {
+            ++commas;
+            if (isToComma) {
+                state.isString = false; // the state was of the block end
+                state.isEscape = false;
+                return begin + index;
+            }
+        }
+        structurals &= structurals - 1;
+    }
+    return begin + 64;
+}
+
+#if defined(CJWD_SIMD_X86)
+inline const char* index_blocks_sse2(const char* begin, const char* end, skip_state& state,
+        uint64_t& commas, const bool isToComma) {
+    while (end - begin >= 64) {
+        const char* found = nullptr;
+        if (state.isComment) {
+            found = index_scalar(begin, begin + 64, state, commas, isToComma);
+        }
+        else {
+            block_t block;
+            classify_sse2(begin, block);
+            found = index_block(block, begin, state, commas, isToComma);
+        }
+        if (found != begin + 64) {
+            return found;
+        }
+        begin += 64;
+    }
+    return index_scalar(begin, end, state, commas, isToComma);
+}
+CJWD_TARGET("avx2")
+inline const char* index_blocks_avx2(const char* begin, const char* end, skip_state& state,
+        uint64_t& commas, const bool isToComma) {
+    while (end - begin >= 64) {
+        const char* found = nullptr;
+        if (state.isComment) {
+            found = index_scalar(begin, begin + 64, state, commas, isToComma);
+        }
+        else {
+            block_t block;
+            classify_avx2(begin, block);
+            found = index_block(block, begin, state, commas, isToComma);
+        }
+        if (found != begin + 64) {
+            return found;
+        }
+        begin += 64;
+    }
+    return index_scalar(begin, end, state, commas, isToComma);
+}
+CJWD_TARGET("avx512f,avx512bw")
+inline const char* index_blocks_avx512(const char* begin, const char* end, skip_state& state,
+        uint64_t& commas, const bool isToComma) {
+    while (end - begin >= 64) {
+        const char* found = nullptr;
+        if (state.isComment) {
+            found = index_scalar(begin, begin + 64, state, commas, isToComma);
+        }
+        else {
+            block_t block;
+            classify_avx512(begin, block);
+            found = index_block(block, begin, state, commas, isToComma);
+        }
+        if (found != begin + 64) {
+            return found;
+        }
+        begin += 64;
+    }
+    return index_scalar(begin, end, state, commas, isToComma);
+}
+#endif // CJWD_SIMD_X86
+
+// Structural pass over the elements of the container opened before `begin`,
+// see index_scalar. The content is not validated.
+inline const char* index_container(const char* begin, const char* end, skip_state& state,
+        uint64_t& commas, const bool isToComma) {
+#if defined(CJWD_SIMD_X86)
+    if (end - begin >= 64) {
+        switch (cpu_isa()) {
+        case isa::avx512:
+            return index_blocks_avx512(begin, end, state, commas, isToComma);
+        case isa::avx2:
+            return index_blocks_avx2(begin, end, state, commas, isToComma);
+        default:
+            return index_blocks_sse2(begin, end, state, commas, isToComma);
+        }
+    }
+#endif
+    return index_scalar(begin, end, state, commas, isToComma);
+}
+
+// Structural index of a document for json_reader::structuralIndex: offsets
+// of brackets, `:`, `,`, quotes and first characters of other tokens outside
+// strings, so the second stage never visits whitespace or string contents.
+struct tape_t {
+    static constexpr uint32_t escapeBit = 0x80000000u; // on the opening quote
+
+    std::vector<uint32_t> offsets;
+    uint32_t size = 0;
+    uint32_t lastQuote = 0;
+    uint64_t prevToken = 1; // the bit after a token or whitespace
+    bool isString = false;
+    bool isEscape = false;
+
+    uint32_t offset(const uint32_t entry) const {
+        return offsets[entry] & ~escapeBit;
+    }
+    // Returns false for comments and backslashes outside strings, the normal
+    // mode parses them.
+    bool add_block(const block_t& block, const uint32_t offset) {
+        const uint64_t quote = (block.backslash == 0) & !isEscape ? block.quote
+            : block.quote & ~escaped_bits(block.backslash, isEscape);
+        const uint64_t inString = prefix_xor(quote) ^ (isString ? ~0ull : 0ull);
+        isString = (inString >> 63) != 0;
+        if (((block.slash | block.backslash) & ~inString) != 0) {
+            return false;
+        }
+        const uint64_t structural = (block.open | block.close | block.comma | block.colon) & ~inString;
+        const uint64_t tokenEnds = structural | (block.space & ~inString) | (quote & ~inString);
+        const uint64_t scalars = ~tokenEnds & ~inString & ((tokenEnds << 1) | prevToken);
+        prevToken = tokenEnds >> 63;
+        const uint64_t entries = structural | quote | scalars;
+        if (size + 64 > offsets.size()) {
+            offsets.resize(offsets.size() * 2 + 64);
+        }
+        // Fixed steps of 8 entries mispredict less than a loop over the
+        // entries, the extra ones are overwritten by the next block.
+        uint32_t* out = offsets.data() + size;
+        const uint32_t count = popcount(entries);
+        uint64_t bits = entries;
+        for (uint32_t i = 0; i < 8; ++i) {
+            out[i] = offset + ctz(bits | (1ull << 63));
+            bits &= bits - 1;
+        }
+        if (count > 8) {
+            for (uint32_t i = 8; i < 16; ++i) {
+                out[i] = offset + ctz(bits | (1ull << 63));
+                bits &= bits - 1;
+            }
+            for (uint32_t i = 16; i < count; ++i) {
+                out[i] = offset + ctz(bits);
+                bits &= bits - 1;
+            }
+        }
+        // An escape marks the last opening quote before it.
+        const uint64_t openQuotes = quote & inString;
+        uint64_t escapes = block.backslash & inString;
+        while (escapes != 0) {
+            const uint64_t quotes = openQuotes & ((escapes & (0 - escapes)) - 1);
+            if (quotes != 0) {
+                lastQuote = size + popcount(entries & ((1ull << (63 - clz(quotes))) - 1));
+            }
+            offsets[lastQuote] |= escapeBit;
+            escapes &= escapes - 1;
+        }
+        if (openQuotes != 0) {
+            lastQuote = size + popcount(entries & ((1ull << (63 - clz(openQuotes))) - 1));
+        }
+        size += count;
+        return true;
+    }
+    // Returns false if the second stage can not be used for the document.
+    bool build(const char* begin, const char* end);
+};
+
+#if defined(CJWD_SIMD_X86)
+// classify_*() with the bitmaps of the structural index, from one load.
+inline void classify_tape_sse2(const char* begin, block_t& block) {
+    __m128i chunks[4];
+    __m128i lower[4];
+    for (uint32_t i = 0; i < 4; ++i) {
+        chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i * 16));
+        lower[i] = _mm_or_si128(chunks[i], _mm_set1_epi8(0x20));
+    }
+    block.quote = movemask_sse2(chunks, '"');
+    block.backslash = movemask_sse2(chunks, '\\');
+    block.slash = movemask_sse2(chunks, '/');
+    block.open = movemask_sse2(lower, '{');
+    block.close = movemask_sse2(lower, '}');
+    block.comma = movemask_sse2(chunks, ',');
+    block.colon = movemask_sse2(chunks, ':');
+    block.space = movemask_sse2(chunks, ' ') | movemask_sse2(chunks, '\n')
+        | movemask_sse2(chunks, '\r') | movemask_sse2(chunks, '\t');
+}
+CJWD_TARGET("avx2")
+inline void classify_tape_avx2(const char* begin, block_t& block) {
+    __m256i chunks[2];
+    __m256i lower[2];
+    for (uint32_t i = 0; i < 2; ++i) {
+        chunks[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i * 32));
+        lower[i] = _mm256_or_si256(chunks[i], _mm256_set1_epi8(0x20));
+    }
+    block.quote = movemask_avx2(chunks, '"');
+    block.backslash = movemask_avx2(chunks, '\\');
+    block.slash = movemask_avx2(chunks, '/');
+    block.open = movemask_avx2(lower, '{');
+    block.close = movemask_avx2(lower, '}');
+    block.comma = movemask_avx2(chunks, ',');
+    block.colon = movemask_avx2(chunks, ':');
+    block.space = movemask_avx2(chunks, ' ') | movemask_avx2(chunks, '\n')
+        | movemask_avx2(chunks, '\r') | movemask_avx2(chunks, '\t');
+}
+CJWD_TARGET("avx512f,avx512bw")
+inline void classify_tape_avx512(const char* begin, block_t& block) {
+    classify_avx512(begin, block);
+    const __m512i chunk = _mm512_loadu_si512(begin);
+    block.comma = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(','));
+    block.colon = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(':'));
+    block.space = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(' '))
+        | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\n'))
+        | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\r'))
+        | _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\t'));
+}
+
+// The last partial block is padded with spaces.
+inline bool tape_blocks_sse2(tape_t& tape, const char* begin, const char* end) {
+    const char* data = begin;
+    block_t block;
+    for (; end - begin >= 64; begin += 64) {
+        classify_tape_sse2(begin, block);
+        if (!tape.add_block(block, static_cast<uint32_t>(begin - data))) {
+            return false;
+        }
+    }
+    char tail[64];
+    std::memset(tail, ' ', sizeof(tail));
+    std::memcpy(tail, begin, end - begin);
+    classify_tape_sse2(tail, block);
+    return tape.add_block(block, static_cast<uint32_t>(begin - data));
+}
+CJWD_TARGET("avx2,popcnt")
+inline bool tape_blocks_avx2(tape_t& tape, const char* begin, const char* end) {
+    const char* data = begin;
+    block_t block;
+    for (; end - begin >= 64; begin += 64) {
+        classify_tape_avx2(begin, block);
+        if (!tape.add_block(block, static_cast<uint32_t>(begin - data))) {
+            return false;
+        }
+    }
+    char tail[64];
+    std::memset(tail, ' ', sizeof(tail));
+    std::memcpy(tail, begin, end - begin);
+    classify_tape_avx2(tail, block);
+    return tape.add_block(block, static_cast<uint32_t>(begin - data));
+}
+CJWD_TARGET("avx512f,avx512bw,popcnt")
+inline bool tape_blocks_avx512(tape_t& tape, const char* begin, const char* end) {
+    const char* data = begin;
+    block_t block;
+    for (; end - begin >= 64; begin += 64) {
+        classify_tape_avx512(begin, block);
+        if (!tape.add_block(block, static_cast<uint32_t>(begin - data))) {
+            return false;
+        }
+    }
+    char tail[64];
+    std::memset(tail, ' ', sizeof(tail));
+    std::memcpy(tail, begin, end - begin);
+    classify_tape_avx512(tail, block);
+    return tape.add_block(block, static_cast<uint32_t>(begin - data));
+}
+#endif // CJWD_SIMD_X86
+
+inline bool tape_t::build(const char* begin, const char* end) {
+    size = 0;
+    lastQuote = 0;
+    prevToken = 1;
+    isString = false;
+    isEscape = false;
+    if (static_cast<uint64_t>(end - begin) >= escapeBit) {
+        return false;
+    }
+    if (offsets.empty()) {
+        offsets.resize((end - begin) / 4 + 64);
+    }
+#if defined(CJWD_SIMD_X86)
+    bool isBuilt = false;
+    switch (cpu_isa()) {
+    case isa::avx512:
+        isBuilt = tape_blocks_avx512(*this, begin, end);
+        break;
+    case isa::avx2:
+        isBuilt = tape_blocks_avx2(*this, begin, end);
+        break;
+    default:
+        isBuilt = tape_blocks_sse2(*this, begin, end);
+        break;
+    }
+    return isBuilt & !isString;
+#else
+    return false; // the normal mode without SIMD
+#endif
+}
+
+// Decimal to double conversion, correctly rounded to nearest-even:
+// Clinger's fast path, Eisel-Lemire with 128-bit powers of five and
+// a big decimal fallback for the rare ambiguous cases.
+
+struct uint128_t {
+    uint64_t low;
+    uint64_t high;
+};
+inline uint128_t multiply(const uint64_t a, const uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128_native_t; // no -Wpedantic warning
+    const uint128_native_t product = static_cast<uint128_native_t>(a) * b;
+    return { static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64) };
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint128_t product;
+    product.low = _umul128(a, b, &product.high);
+    return product;
+#else
+    const uint64_t aLow = static_cast<uint32_t>(a);
+    const uint64_t aHigh = a >> 32;
+    const uint64_t bLow = static_cast<uint32_t>(b);
+    const uint64_t bHigh = b >> 32;
+    const uint64_t lowLow = aLow * bLow;
+    const uint64_t highLow = aHigh * bLow;
+    const uint64_t lowHigh = aLow * bHigh;
+    const uint64_t cross = (lowLow >> 32) + static_cast<uint32_t>(highLow) + lowHigh;
+    return {
+        (cross << 32) | static_cast<uint32_t>(lowLow),
+        aHigh * bHigh + (highLow >> 32) + (cross >> 32)
+    };
+#endif
+}
+
+// Truncated 128-bit 5^q for q in [-342, 308], normalized to the top bit.
+inline const uint64_t* powers_of_five() {
+    static const uint64_t table[] = {
+        0xeef453d6923bd65a, 0x113faa2906a13b3f,
+        0x9558b4661b6565f8, 0x4ac7ca59a424c507,
+        0xbaaee17fa23ebf76, 0x5d79bcf00d2df649,
+        0xe95a99df8ace6f53, 0xf4d82c2c107973dc,
+        0x91d8a02bb6c10594, 0x79071b9b8a4be869,
+        0xb64ec836a47146f9, 0x9748e2826cdee284,
+        0xe3e27a444d8d98b7, 0xfd1b1b2308169b25,
+        0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,
+        0xb208ef855c969f4f, 0xbdbd2d335e51a935,
+        0xde8b2b66b3bc4723, 0xad2c788035e61382,
+        0x8b16fb203055ac76, 0x4c3bcb5021afcc31,
+        0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,
+        0xd953e8624b85dd78, 0xd71d6dad34a2af0d,
+        0x87d4713d6f33aa6b, 0x8672648c40e5ad68,
+        0xa9c98d8ccb009506, 0x680efdaf511f18c2,
+        0xd43bf0effdc0ba48, 0x0212bd1b2566def2,
+        0x84a57695fe98746d, 0x014bb630f7604b57,
+        0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,
+        0xcf42894a5dce35ea, 0x52064cac828675b9,
+        0x818995ce7aa0e1b2, 0x7343efebd1940993,
+        0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8,
+        0xca66fa129f9b60a6, 0xd41a26e077774ef6,
+        0xfd00b897478238d0, 0x8920b098955522b4,
+        0x9e20735e8cb16382, 0x55b46e5f5d5535b0,
+        0xc5a890362fddbc62, 0xeb2189f734aa831d,
+        0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,
+        0x9a6bb0aa55653b2d, 0x47b233c92125366e,
+        0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+        0xf148440a256e2c76, 0xc00670ea43ca250d,
+        0x96cd2a865764dbca, 0x380406926a5e5728,
+        0xbc807527ed3e12bc, 0xc605083704f5ecf2,
+        0xeba09271e88d976b, 0xf7864a44c633682e,
+        0x93445b8731587ea3, 0x7ab3ee6afbe0211d,
+        0xb8157268fdae9e4c, 0x5960ea05bad82964,
+        0xe61acf033d1a45df, 0x6fb92487298e33bd,
+        0x8fd0c16206306bab, 0xa5d3b6d479f8e056,
+        0xb3c4f1ba87bc8696, 0x8f48a4899877186c,
+        0xe0b62e2929aba83c, 0x331acdabfe94de87,
+        0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14,
+        0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,
+        0xdb71e91432b1a24a, 0xc9e82cd9f69d6150,
+        0x892731ac9faf056e, 0xbe311c083a225cd2,
+        0xab70fe17c79ac6ca, 0x6dbd630a48aaf406,
+        0xd64d3d9db981787d, 0x092cbbccdad5b108,
+        0x85f0468293f0eb4e, 0x25bbf56008c58ea5,
+        0xa76c582338ed2621, 0xaf2af2b80af6f24e,
+        0xd1476e2c07286faa, 0x1af5af660db4aee1,
+        0x82cca4db847945ca, 0x50d98d9fc890ed4d,
+        0xa37fce126597973c, 0xe50ff107bab528a0,
+        0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,
+        0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a,
+        0x9faacf3df73609b1, 0x77b191618c54e9ac,
+        0xc795830d75038c1d, 0xd59df5b9ef6a2417,
+        0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,
+        0x9becce62836ac577, 0x4ee367f9430aec32,
+        0xc2e801fb244576d5, 0x229c41f793cda73f,
+        0xf3a20279ed56d48a, 0x6b43527578c1110f,
+        0x9845418c345644d6, 0x830a13896b78aaa9,
+        0xbe5691ef416bd60c, 0x23cc986bc656d553,
+        0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,
+        0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9,
+        0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,
+        0xe858ad248f5c22c9, 0xd1b3400f8f9cff68,
+        0x91376c36d99995be, 0x23100809b9c21fa1,
+        0xb58547448ffffb2d, 0xabd40a0c2832a78a,
+        0xe2e69915b3fff9f9, 0x16c90c8f323f516c,
+        0x8dd01fad907ffc3b, 0xae3da7d97f6792e3,
+        0xb1442798f49ffb4a, 0x99cd11cfdf41779c,
+        0xdd95317f31c7fa1d, 0x40405643d711d583,
+        0x8a7d3eef7f1cfc52, 0x482835ea666b2572,
+        0xad1c8eab5ee43b66, 0xda3243650005eecf,
+        0xd863b256369d4a40, 0x90bed43e40076a82,
+        0x873e4f75e2224e68, 0x5a7744a6e804a291,
+        0xa90de3535aaae202, 0x711515d0a205cb36,
+        0xd3515c2831559a83, 0x0d5a5b44ca873e03,
+        0x8412d9991ed58091, 0xe858790afe9486c2,
+        0xa5178fff668ae0b6, 0x626e974dbe39a872,
+        0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,
+        0x80fa687f881c7f8e, 0x7ce66634bc9d0b99,
+        0xa139029f6a239f72, 0x1c1fffc1ebc44e80,
+        0xc987434744ac874e, 0xa327ffb266b56220,
+        0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+        0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9,
+        0xc4ce17b399107c22, 0xcb550fb4384d21d3,
+        0xf6019da07f549b2b, 0x7e2a53a146606a48,
+        0x99c102844f94e0fb, 0x2eda7444cbfc426d,
+        0xc0314325637a1939, 0xfa911155fefb5308,
+        0xf03d93eebc589f88, 0x793555ab7eba27ca,
+        0x96267c7535b763b5, 0x4bc1558b2f3458de,
+        0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,
+        0xea9c227723ee8bcb, 0x465e15a979c1cadc,
+        0x92a1958a7675175f, 0x0bfacd89ec191ec9,
+        0xb749faed14125d36, 0xcef980ec671f667b,
+        0xe51c79a85916f484, 0x82b7e12780e7401a,
+        0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810,
+        0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,
+        0xdfbdcece67006ac9, 0x67a791e093e1d49a,
+        0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,
+        0xaecc49914078536d, 0x58fae9f773886e18,
+        0xda7f5bf590966848, 0xaf39a475506a899e,
+        0x888f99797a5e012d, 0x6d8406c952429603,
+        0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,
+        0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64,
+        0x855c3be0a17fcd26, 0x5cf2eea09a55067f,
+        0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e,
+        0xd0601d8efc57b08b, 0xf13b94daf124da26,
+        0x823c12795db6ce57, 0x76c53d08d6b70858,
+        0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,
+        0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09,
+        0xfe5d54150b090b02, 0xd3f93b35435d7c4c,
+        0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf,
+        0xc6b8e9b0709f109a, 0x359ab6419ca1091b,
+        0xf867241c8cc6d4c0, 0xc30163d203c94b62,
+        0x9b407691d7fc44f8, 0x79e0de63425dcf1d,
+        0xc21094364dfb5636, 0x985915fc12f542e4,
+        0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,
+        0x979cf3ca6cec5b5a, 0xa705992ceecf9c42,
+        0xbd8430bd08277231, 0x50c6ff782a838353,
+        0xece53cec4a314ebd, 0xa4f8bf5635246428,
+        0x940f4613ae5ed136, 0x871b7795e136be99,
+        0xb913179899f68584, 0x28e2557b59846e3f,
+        0xe757dd7ec07426e5, 0x331aeada2fe589cf,
+        0x9096ea6f3848984f, 0x3ff0d2c85def7621,
+        0xb4bca50b065abe63, 0x0fed077a756b53a9,
+        0xe1ebce4dc7f16dfb, 0xd3e8495912c62894,
+        0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,
+        0xb080392cc4349dec, 0xbd8d794d96aacfb3,
+        0xdca04777f541c567, 0xecf0d7a0fc5583a0,
+        0x89e42caaf9491b60, 0xf41686c49db57244,
+        0xac5d37d5b79b6239, 0x311c2875c522ced5,
+        0xd77485cb25823ac7, 0x7d633293366b828b,
+        0x86a8d39ef77164bc, 0xae5dff9c02033197,
+        0xa8530886b54dbdeb, 0xd9f57f830283fdfc,
+        0xd267caa862a12d66, 0xd072df63c324fd7b,
+        0x8380dea93da4bc60, 0x4247cb9e59f71e6d,
+        0xa46116538d0deb78, 0x52d9be85f074e608,
+        0xcd795be870516656, 0x67902e276c921f8b,
+        0x806bd9714632dff6, 0x00ba1cd8a3db53b6,
+        0xa086cfcd97bf97f3, 0x80e8a40eccd228a4,
+        0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,
+        0xfad2a4b13d1b5d6c, 0x796b805720085f81,
+        0x9cc3a6eec6311a63, 0xcbe3303674053bb0,
+        0xc3f490aa77bd60fc, 0xbedbfc4411068a9c,
+        0xf4f1b4d515acb93b, 0xee92fb5515482d44,
+        0x991711052d8bf3c5, 0x751bdd152d4d1c4a,
+        0xbf5cd54678eef0b6, 0xd262d45a78a0635d,
+        0xef340a98172aace4, 0x86fb897116c87c34,
+        0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,
+        0xbae0a846d2195712, 0x8974836059cca109,
+        0xe998d258869facd7, 0x2bd1a438703fc94b,
+        0x91ff83775423cc06, 0x7b6306a34627ddcf,
+        0xb67f6455292cbf08, 0x1a3bc84c17b1d542,
+        0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93,
+        0x8e938662882af53e, 0x547eb47b7282ee9c,
+        0xb23867fb2a35b28d, 0xe99e619a4f23aa43,
+        0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,
+        0x8b3c113c38f9f37e, 0xde83bc408dd3dd04,
+        0xae0b158b4738705e, 0x9624ab50b148d445,
+        0xd98ddaee19068c76, 0x3badd624dd9b0957,
+        0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,
+        0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c,
+        0xd47487cc8470652b, 0x7647c3200069671f,
+        0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073,
+        0xa5fb0a17c777cf09, 0xf468107100525890,
+        0xcf79cc9db955c2cc, 0x7182148d4066eeb4,
+        0x81ac1fe293d599bf, 0xc6f14cd848405530,
+        0xa21727db38cb002f, 0xb8ada00e5a506a7c,
+        0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,
+        0xfd442e4688bd304a, 0x908f4a166d1da663,
+        0x9e4a9cec15763e2e, 0x9a598e4e043287fe,
+        0xc5dd44271ad3cdba, 0x40eff1e1853f29fd,
+        0xf7549530e188c128, 0xd12bee59e68ef47c,
+        0x9a94dd3e8cf578b9, 0x82bb74f8301958ce,
+        0xc13a148e3032d6e7, 0xe36a52363c1faf01,
+        0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1,
+        0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,
+        0xbcb2b812db11a5de, 0x7415d448f6b6f0e7,
+        0xebdf661791d60f56, 0x111b495b3464ad21,
+        0x936b9fcebb25c995, 0xcab10dd900beec34,
+        0xb84687c269ef3bfb, 0x3d5d514f40eea742,
+        0xe65829b3046b0afa, 0x0cb4a5a3112a5112,
+        0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,
+        0xb3f4e093db73a093, 0x59ed216765690f56,
+        0xe0f218b8d25088b8, 0x306869c13ec3532c,
+        0x8c974f7383725573, 0x1e414218c73a13fb,
+        0xafbd2350644eeacf, 0xe5d1929ef90898fa,
+        0xdbac6c247d62a583, 0xdf45f746b74abf39,
+        0x894bc396ce5da772, 0x6b8bba8c328eb783,
+        0xab9eb47c81f5114f, 0x066ea92f3f326564,
+        0xd686619ba27255a2, 0xc80a537b0efefebd,
+        0x8613fd0145877585, 0xbd06742ce95f5f36,
+        0xa798fc4196e952e7, 0x2c48113823b73704,
+        0xd17f3b51fca3a7a0, 0xf75a15862ca504c5,
+        0x82ef85133de648c4, 0x9a984d73dbe722fb,
+        0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba,
+        0xcc963fee10b7d1b3, 0x318df905079926a8,
+        0xffbbcfe994e5c61f, 0xfdf17746497f7052,
+        0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,
+        0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0,
+        0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,
+        0x9c1661a651213e2d, 0x06bea10ca65c084e,
+        0xc31bfa0fe5698db8, 0x486e494fcff30a62,
+        0xf3e2f893dec3f126, 0x5a89dba3c3efccfa,
+        0x986ddb5c6b3a76b7, 0xf89629465a75e01c,
+        0xbe89523386091465, 0xf6bbb397f1135823,
+        0xee2ba6c0678b597f, 0x746aa07ded582e2c,
+        0x94db483840b717ef, 0xa8c2a44eb4571cdc,
+        0xba121a4650e4ddeb, 0x92f34d62616ce413,
+        0xe896a0d7e51e1566, 0x77b020baf9c81d17,
+        0x915e2486ef32cd60, 0x0ace1474dc1d122e,
+        0xb5b5ada8aaff80b8, 0x0d819992132456ba,
+        0xe3231912d5bf60e6, 0x10e1fff697ed6c69,
+        0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1,
+        0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,
+        0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde,
+        0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,
+        0xad4ab7112eb3929d, 0x86c16c98d2c953c6,
+        0xd89d64d57a607744, 0xe871c7bf077ba8b7,
+        0x87625f056c7c4a8b, 0x11471cd764ad4972,
+        0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,
+        0xd389b47879823479, 0x4aff1d108d4ec2c3,
+        0x843610cb4bf160cb, 0xcedf722a585139ba,
+        0xa54394fe1eedb8fe, 0xc2974eb4ee658828,
+        0xce947a3da6a9273e, 0x733d226229feea32,
+        0x811ccc668829b887, 0x0806357d5a3f525f,
+        0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,
+        0xc9bcff6034c13052, 0xfc89b393dd02f0b5,
+        0xfc2c3f3841f17c67, 0xbbac2078d443ace2,
+        0x9d9ba7832936edc0, 0xd54b944b84aa4c0d,
+        0xc5029163f384a931, 0x0a9e795e65d4df11,
+        0xf64335bcf065d37d, 0x4d4617b5ff4a16d5,
+        0x99ea0196163fa42e, 0x504bced1bf8e4e45,
+        0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6,
+        0xf07da27a82c37088, 0x5d767327bb4e5a4c,
+        0x964e858c91ba2655, 0x3a6a07f8d510f86f,
+        0xbbe226efb628afea, 0x890489f70a55368b,
+        0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e,
+        0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,
+        0xb77ada0617e3bbcb, 0x09ce6ebb40173744,
+        0xe55990879ddcaabd, 0xcc420a6a101d0515,
+        0x8f57fa54c2a9eab6, 0x9fa946824a12232d,
+        0xb32df8e9f3546564, 0x47939822dc96abf9,
+        0xdff9772470297ebd, 0x59787e2b93bc56f7,
+        0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+        0xaefae51477a06b03, 0xede622920b6b23f1,
+        0xdab99e59958885c4, 0xe95fab368e45eced,
+        0x88b402f7fd75539b, 0x11dbcb0218ebb414,
+        0xaae103b5fcd2a881, 0xd652bdc29f26a119,
+        0xd59944a37c0752a2, 0x4be76d3346f0495f,
+        0x857fcae62d8493a5, 0x6f70a4400c562ddb,
+        0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952,
+        0xd097ad07a71f26b2, 0x7e2000a41346a7a7,
+        0x825ecc24c873782f, 0x8ed400668c0c28c8,
+        0xa2f67f2dfa90563b, 0x728900802f0f32fa,
+        0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9,
+        0xfea126b7d78186bc, 0xe2f610c84987bfa8,
+        0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9,
+        0xc6ede63fa05d3143, 0x91503d1c79720dbb,
+        0xf8a95fcf88747d94, 0x75a44c6397ce912a,
+        0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,
+        0xc24452da229b021b, 0xfbe85badce996168,
+        0xf2d56790ab41c2a2, 0xfae27299423fb9c3,
+        0x97c560ba6b0919a5, 0xdccd879fc967d41a,
+        0xbdb6b8e905cb600f, 0x5400e987bbc1c920,
+        0xed246723473e3813, 0x290123e9aab23b68,
+        0x9436c0760c86e30b, 0xf9a0b6720aaf6521,
+        0xb94470938fa89bce, 0xf808e40e8d5b3e69,
+        0xe7958cb87392c2c2, 0xb60b1d1230b20e04,
+        0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2,
+        0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,
+        0xe2280b6c20dd5232, 0x25c6da63c38de1b0,
+        0x8d590723948a535f, 0x579c487e5a38ad0e,
+        0xb0af48ec79ace837, 0x2d835a9df0c6d851,
+        0xdcdb1b2798182244, 0xf8e431456cf88e65,
+        0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff,
+        0xac8b2d36eed2dac5, 0xe272467e3d222f3f,
+        0xd7adf884aa879177, 0x5b0ed81dcc6abb0f,
+        0x86ccbb52ea94baea, 0x98e947129fc2b4e9,
+        0xa87fea27a539e9a5, 0x3f2398d747b36224,
+        0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,
+        0x83a3eeeef9153e89, 0x1953cf68300424ac,
+        0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,
+        0xcdb02555653131b6, 0x3792f412cb06794d,
+        0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,
+        0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4,
+        0xc8de047564d20a8b, 0xf245825a5a445275,
+        0xfb158592be068d2e, 0xeed6e2f0f0d56712,
+        0x9ced737bb6c4183d, 0x55464dd69685606b,
+        0xc428d05aa4751e4c, 0xaa97e14c3c26b886,
+        0xf53304714d9265df, 0xd53dd99f4b3066a8,
+        0x993fe2c6d07b7fab, 0xe546a8038efe4029,
+        0xbf8fdb78849a5f96, 0xde98520472bdd033,
+        0xef73d256a5c0f77c, 0x963e66858f6d4440,
+        0x95a8637627989aad, 0xdde7001379a44aa8,
+        0xbb127c53b17ec159, 0x5560c018580d5d52,
+        0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,
+        0x9226712162ab070d, 0xcab3961304ca70e8,
+        0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+        0xe45c10c42a2b3b05, 0x8cb89a7db77c506a,
+        0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,
+        0xb267ed1940f1c61c, 0x55f038b237591ed3,
+        0xdf01e85f912e37a3, 0x6b6c46dec52f6688,
+        0x8b61313bbabce2c6, 0x2323ac4b3b3da015,
+        0xae397d8aa96c1b77, 0xabec975e0a0d081a,
+        0xd9c7dced53c72255, 0x96e7bd358c904a21,
+        0x881cea14545c7575, 0x7e50d64177da2e54,
+        0xaa242499697392d2, 0xdde50bd1d5d0b9e9,
+        0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,
+        0x84ec3c97da624ab4, 0xbd5af13bef0b113e,
+        0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,
+        0xcfb11ead453994ba, 0x67de18eda5814af2,
+        0x81ceb32c4b43fcf4, 0x80eacf948770ced7,
+        0xa2425ff75e14fc31, 0xa1258379a94d028d,
+        0xcad2f7f5359a3b3e, 0x096ee45813a04330,
+        0xfd87b5f28300ca0d, 0x8bca9d6e188853fc,
+        0x9e74d1b791e07e48, 0x775ea264cf55347e,
+        0xc612062576589dda, 0x95364afe032a819e,
+        0xf79687aed3eec551, 0x3a83ddbd83f52205,
+        0x9abe14cd44753b52, 0xc4926a9672793543,
+        0xc16d9a0095928a27, 0x75b7053c0f178294,
+        0xf1c90080baf72cb1, 0x5324c68b12dd6339,
+        0x971da05074da7bee, 0xd3f6fc16ebca5e04,
+        0xbce5086492111aea, 0x88f4bb1ca6bcf585,
+        0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,
+        0x9392ee8e921d5d07, 0x3aff322e62439fd0,
+        0xb877aa3236a4b449, 0x09befeb9fad487c3,
+        0xe69594bec44de15b, 0x4c2ebe687989a9b4,
+        0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,
+        0xb424dc35095cd80f, 0x538484c19ef38c95,
+        0xe12e13424bb40e13, 0x2865a5f206b06fba,
+        0x8cbccc096f5088cb, 0xf93f87b7442e45d4,
+        0xafebff0bcb24aafe, 0xf78f69a51539d749,
+        0xdbe6fecebdedd5be, 0xb573440e5a884d1c,
+        0x89705f4136b4a597, 0x31680a88f8953031,
+        0xabcc77118461cefc, 0xfdc20d2b36ba7c3e,
+        0xd6bf94d5e57a42bc, 0x3d32907604691b4d,
+        0x8637bd05af6c69b5, 0xa63f9a49c2c1b110,
+        0xa7c5ac471b478423, 0x0fcf80dc33721d54,
+        0xd1b71758e219652b, 0xd3c36113404ea4a9,
+        0x83126e978d4fdf3b, 0x645a1cac083126ea,
+        0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4,
+        0xcccccccccccccccc, 0xcccccccccccccccd,
+        0x8000000000000000, 0x0000000000000000,
+        0xa000000000000000, 0x0000000000000000,
+        0xc800000000000000, 0x0000000000000000,
+        0xfa00000000000000, 0x0000000000000000,
+        0x9c40000000000000, 0x0000000000000000,
+        0xc350000000000000, 0x0000000000000000,
+        0xf424000000000000, 0x0000000000000000,
+        0x9896800000000000, 0x0000000000000000,
+        0xbebc200000000000, 0x0000000000000000,
+        0xee6b280000000000, 0x0000000000000000,
+        0x9502f90000000000, 0x0000000000000000,
+        0xba43b74000000000, 0x0000000000000000,
+        0xe8d4a51000000000, 0x0000000000000000,
+        0x9184e72a00000000, 0x0000000000000000,
+        0xb5e620f480000000, 0x0000000000000000,
+        0xe35fa931a0000000, 0x0000000000000000,
+        0x8e1bc9bf04000000, 0x0000000000000000,
+        0xb1a2bc2ec5000000, 0x0000000000000000,
+        0xde0b6b3a76400000, 0x0000000000000000,
+        0x8ac7230489e80000, 0x0000000000000000,
+        0xad78ebc5ac620000, 0x0000000000000000,
+        0xd8d726b7177a8000, 0x0000000000000000,
+        0x878678326eac9000, 0x0000000000000000,
+        0xa968163f0a57b400, 0x0000000000000000,
+        0xd3c21bcecceda100, 0x0000000000000000,
+        0x84595161401484a0, 0x0000000000000000,
+        0xa56fa5b99019a5c8, 0x0000000000000000,
+        0xcecb8f27f4200f3a, 0x0000000000000000,
+        0x813f3978f8940984, 0x4000000000000000,
+        0xa18f07d736b90be5, 0x5000000000000000,
+        0xc9f2c9cd04674ede, 0xa400000000000000,
+        0xfc6f7c4045812296, 0x4d00000000000000,
+        0x9dc5ada82b70b59d, 0xf020000000000000,
+        0xc5371912364ce305, 0x6c28000000000000,
+        0xf684df56c3e01bc6, 0xc732000000000000,
+        0x9a130b963a6c115c, 0x3c7f400000000000,
+        0xc097ce7bc90715b3, 0x4b9f100000000000,
+        0xf0bdc21abb48db20, 0x1e86d40000000000,
+        0x96769950b50d88f4, 0x1314448000000000,
+        0xbc143fa4e250eb31, 0x17d955a000000000,
+        0xeb194f8e1ae525fd, 0x5dcfab0800000000,
+        0x92efd1b8d0cf37be, 0x5aa1cae500000000,
+        0xb7abc627050305ad, 0xf14a3d9e40000000,
+        0xe596b7b0c643c719, 0x6d9ccd05d0000000,
+        0x8f7e32ce7bea5c6f, 0xe4820023a2000000,
+        0xb35dbf821ae4f38b, 0xdda2802c8a800000,
+        0xe0352f62a19e306e, 0xd50b2037ad200000,
+        0x8c213d9da502de45, 0x4526f422cc340000,
+        0xaf298d050e4395d6, 0x9670b12b7f410000,
+        0xdaf3f04651d47b4c, 0x3c0cdd765f114000,
+        0x88d8762bf324cd0f, 0xa5880a69fb6ac800,
+        0xab0e93b6efee0053, 0x8eea0d047a457a00,
+        0xd5d238a4abe98068, 0x72a4904598d6d880,
+        0x85a36366eb71f041, 0x47a6da2b7f864750,
+        0xa70c3c40a64e6c51, 0x999090b65f67d924,
+        0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,
+        0x82818f1281ed449f, 0xbff8f10e7a8921a4,
+        0xa321f2d7226895c7, 0xaff72d52192b6a0d,
+        0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490,
+        0xfee50b7025c36a08, 0x02f236d04753d5b4,
+        0x9f4f2726179a2245, 0x01d762422c946590,
+        0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,
+        0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2,
+        0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+        0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb,
+        0xf316271c7fc3908a, 0x8bef464e3945ef7a,
+        0x97edd871cfda3a56, 0x97758bf0e3cbb5ac,
+        0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,
+        0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd,
+        0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,
+        0xb975d6b6ee39e436, 0xb3e2fd538e122b44,
+        0xe7d34c64a9c85d44, 0x60dbbca87196b616,
+        0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd,
+        0xb51d13aea4a488dd, 0x6babab6398bdbe41,
+        0xe264589a4dcdab14, 0xc696963c7eed2dd1,
+        0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,
+        0xb0de65388cc8ada8, 0x3b25a55f43294bcb,
+        0xdd15fe86affad912, 0x49ef0eb713f39ebe,
+        0x8a2dbf142dfcc7ab, 0x6e3569326c784337,
+        0xacb92ed9397bf996, 0x49c2c37f07965404,
+        0xd7e77a8f87daf7fb, 0xdc33745ec97be906,
+        0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,
+        0xa8acd7c0222311bc, 0xc40832ea0d68ce0c,
+        0xd2d80db02aabd62b, 0xf50a3fa490c30190,
+        0x83c7088e1aab65db, 0x792667c6da79e0fa,
+        0xa4b8cab1a1563f52, 0x577001b891185938,
+        0xcde6fd5e09abcf26, 0xed4c0226b55e6f86,
+        0x80b05e5ac60b6178, 0x544f8158315b05b4,
+        0xa0dc75f1778e39d6, 0x696361ae3db1c721,
+        0xc913936dd571c84c, 0x03bc3a19cd1e38e9,
+        0xfb5878494ace3a5f, 0x04ab48a04065c723,
+        0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,
+        0xc45d1df942711d9a, 0x3ba5d0bd324f8394,
+        0xf5746577930d6500, 0xca8f44ec7ee36479,
+        0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb,
+        0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,
+        0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e,
+        0x95d04aee3b80ece5, 0xbba1f1d158724a12,
+        0xbb445da9ca61281f, 0x2a8a6e45ae8edc97,
+        0xea1575143cf97226, 0xf52d09d71a3293bd,
+        0x924d692ca61be758, 0x593c2626705f9c56,
+        0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,
+        0xe498f455c38b997a, 0x0b6dfb9c0f956447,
+        0x8edf98b59a373fec, 0x4724bd4189bd5eac,
+        0xb2977ee300c50fe7, 0x58edec91ec2cb657,
+        0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,
+        0x8b865b215899f46c, 0xbd79e0d20082ee74,
+        0xae67f1e9aec07187, 0xecd8590680a3aa11,
+        0xda01ee641a708de9, 0xe80e6f4820cc9495,
+        0x884134fe908658b2, 0x3109058d147fdcdd,
+        0xaa51823e34a7eede, 0xbd4b46f0599fd415,
+        0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,
+        0x850fadc09923329e, 0x03e2cf6bc604ddb0,
+        0xa6539930bf6bff45, 0x84db8346b786151c,
+        0xcfe87f7cef46ff16, 0xe612641865679a63,
+        0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,
+        0xa26da3999aef7749, 0xe3be5e330f38f09d,
+        0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+        0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6,
+        0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,
+        0xc646d63501a1511d, 0xb281e1fd541501b8,
+        0xf7d88bc24209a565, 0x1f225a7ca91a4226,
+        0x9ae757596946075f, 0x3375788de9b06958,
+        0xc1a12d2fc3978937, 0x0052d6b1641c83ae,
+        0xf209787bb47d6b84, 0xc0678c5dbd23a49a,
+        0x9745eb4d50ce6332, 0xf840b7ba963646e0,
+        0xbd176620a501fbff, 0xb650e5a93bc3d898,
+        0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,
+        0x93ba47c980e98cdf, 0xc66f336c36b10137,
+        0xb8a8d9bbe123f017, 0xb80b0047445d4184,
+        0xe6d3102ad96cec1d, 0xa60dc059157491e5,
+        0x9043ea1ac7e41392, 0x87c89837ad68db2f,
+        0xb454e4a179dd1877, 0x29babe4598c311fb,
+        0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,
+        0x8ce2529e2734bb1d, 0x1899e4a65f58660c,
+        0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,
+        0xdc21a1171d42645d, 0x76707543f4fa1f73,
+        0x899504ae72497eba, 0x6a06494a791c53a8,
+        0xabfa45da0edbde69, 0x0487db9d17636892,
+        0xd6f8d7509292d603, 0x45a9d2845d3c42b6,
+        0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2,
+        0xa7f26836f282b732, 0x8e6cac7768d7141e,
+        0xd1ef0244af2364ff, 0x3207d795430cd926,
+        0x8335616aed761f1f, 0x7f44e6bd49e807b8,
+        0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6,
+        0xcd036837130890a1, 0x36dba887c37a8c0f,
+        0x802221226be55a64, 0xc2494954da2c9789,
+        0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,
+        0xc83553c5c8965d3d, 0x6f92829494e5acc7,
+        0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,
+        0x9c69a97284b578d7, 0xff2a760414536efb,
+        0xc38413cf25e2d70d, 0xfef5138519684aba,
+        0xf46518c2ef5b8cd1, 0x7eb258665fc25d69,
+        0x98bf2f79d5993802, 0xef2f773ffbd97a61,
+        0xbeeefb584aff8603, 0xaafb550ffacfd8fa,
+        0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,
+        0x952ab45cfa97a0b2, 0xdd945a747bf26183,
+        0xba756174393d88df, 0x94f971119aeef9e4,
+        0xe912b9d1478ceb17, 0x7a37cd5601aab85d,
+        0x91abb422ccb812ee, 0xac62e055c10ab33a,
+        0xb616a12b7fe617aa, 0x577b986b314d6009,
+        0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,
+        0x8e41ade9fbebc27d, 0x14588f13be847307,
+        0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,
+        0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb,
+        0x8aec23d680043bee, 0x25de7bb9480d5854,
+        0xada72ccc20054ae9, 0xaf561aa79a10ae6a,
+        0xd910f7ff28069da4, 0x1b2ba1518094da04,
+        0x87aa9aff79042286, 0x90fb44d2f05d0842,
+        0xa99541bf57452b28, 0x353a1607ac744a53,
+        0xd3fa922f2d1675f2, 0x42889b8997915ce8,
+        0x847c9b5d7c2e09b7, 0x69956135febada11,
+        0xa59bc234db398c25, 0x43fab9837e699095,
+        0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,
+        0x8161afb94b44f57d, 0x1d1be0eebac278f5,
+        0xa1ba1ba79e1632dc, 0x6462d92a69731732,
+        0xca28a291859bbf93, 0x7d7b8f7503cfdcfe,
+        0xfcb2cb35e702af78, 0x5cda735244c3d43e,
+        0x9defbf01b061adab, 0x3a0888136afa64a7,
+        0xc56baec21c7a1916, 0x088aaa1845b8fdd0,
+        0xf6c69a72a3989f5b, 0x8aad549e57273d45,
+        0x9a3c2087a63f6399, 0x36ac54e2f678864b,
+        0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd,
+        0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,
+        0x969eb7c47859e743, 0x9f644ae5a4b1b325,
+        0xbc4665b596706114, 0x873d5d9f0dde1fee,
+        0xeb57ff22fc0c7959, 0xa90cb506d155a7ea,
+        0x9316ff75dd87cbd8, 0x09a7f12442d588f2,
+        0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f,
+        0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,
+        0x8fa475791a569d10, 0xf96e017d694487bc,
+        0xb38d92d760ec4455, 0x37c981dcc395a9ac,
+        0xe070f78d3927556a, 0x85bbe253f47b1417,
+        0x8c469ab843b89562, 0x93956d7478ccec8e,
+        0xaf58416654a6babb, 0x387ac8d1970027b2,
+        0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,
+        0x88fcf317f22241e2, 0x441fece3bdf81f03,
+        0xab3c2fddeeaad25a, 0xd527e81cad7626c3,
+        0xd60b3bd56a5586f1, 0x8a71e223d8d3b074,
+        0x85c7056562757456, 0xf6872d5667844e49,
+        0xa738c6bebb12d16c, 0xb428f8ac016561db,
+        0xd106f86e69d785c7, 0xe13336d701beba52,
+        0x82a45b450226b39c, 0xecc0024661173473,
+        0xa34d721642b06084, 0x27f002d7f95d0190,
+        0xcc20ce9bd35c78a5, 0x31ec038df7b441f4,
+        0xff290242c83396ce, 0x7e67047175a15271,
+        0x9f79a169bd203e41, 0x0f0062c6e984d386,
+        0xc75809c42c684dd1, 0x52c07b78a3e60868,
+        0xf92e0c3537826145, 0xa7709a56ccdf8a82,
+        0x9bbcc7a142b17ccb, 0x88a66076400bb691,
+        0xc2abf989935ddbfe, 0x6acff893d00ea435,
+        0xf356f7ebf83552fe, 0x0583f6b8c4124d43,
+        0x98165af37b2153de, 0xc3727a337a8b704a,
+        0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,
+        0xeda2ee1c7064130c, 0x1162def06f79df73,
+        0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,
+        0xb9a74a0637ce2ee1, 0x6d953e2bd7173692,
+        0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,
+        0x910ab1d4db9914a0, 0x1d9c9892400a22a2,
+        0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,
+        0xe2a0b5dc971f303a, 0x2e44ae64840fd61d,
+        0x8da471a9de737e24, 0x5ceaecfed289e5d2,
+        0xb10d8e1456105dad, 0x7425a83e872c5f47,
+        0xdd50f1996b947518, 0xd12f124e28f77719,
+        0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f,
+        0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+        0xd8210befd30efa5a, 0x3c47f7e05401aa4e,
+        0x8714a775e3e95c78, 0x65acfaec34810a71,
+        0xa8d9d1535ce3b396, 0x7f1839a741a14d0d,
+        0xd31045a8341ca07c, 0x1ede48111209a050,
+        0x83ea2b892091e44d, 0x934aed0aab460432,
+        0xa4e4b66b68b65d60, 0xf81da84d5617853f,
+        0xce1de40642e3f4b9, 0x36251260ab9d668e,
+        0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,
+        0xa1075a24e4421730, 0xb24cf65b8612f81f,
+        0xc94930ae1d529cfc, 0xdee033f26797b627,
+        0xfb9b7cd9a4a7443c, 0x169840ef017da3b1,
+        0x9d412e0806e88aa5, 0x8e1f289560ee864e,
+        0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2,
+        0xf5b5d7ec8acb58a2, 0xae10af696774b1db,
+        0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29,
+        0xbff610b0cc6edd3f, 0x17fd090a58d32af3,
+        0xeff394dcff8a948e, 0xddfc4b4cef07f5b0,
+        0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,
+        0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1,
+        0xea53df5fd18d5513, 0x84c86189216dc5ed,
+        0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4,
+        0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,
+        0xe4d5e82392a40515, 0x0fabaf3feaa5334a,
+        0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,
+        0xb2c71d5bca9023f8, 0x743e20e9ef511012,
+        0xdf78e4b2bd342cf6, 0x914da9246b255416,
+        0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e,
+        0xae9672aba3d0c320, 0xa184ac2473b529b1,
+        0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e,
+        0x8865899617fb1871, 0x7e2fa67c7a658892,
+        0xaa7eebfb9df9de8d, 0xddbb901b98feeab7,
+        0xd51ea6fa85785631, 0x552a74227f3ea565,
+        0x8533285c936b35de, 0xd53a88958f87275f,
+        0xa67ff273b8460356, 0x8a892abaf368f137,
+        0xd01fef10a657842c, 0x2d2b7569b0432d85,
+        0x8213f56a67f6b29b, 0x9c3b29620e29fc73,
+        0xa298f2c501f45f42, 0x8349f3ba91b47b8f,
+        0xcb3f2f7642717713, 0x241c70a936219a73,
+        0xfe0efb53d30dd4d7, 0xed238cd383aa0110,
+        0x9ec95d1463e8a506, 0xf4363804324a40aa,
+        0xc67bb4597ce2ce48, 0xb143c6053edcd0d5,
+        0xf81aa16fdc1b81da, 0xdd94b7868e94050a,
+        0x9b10a4e5e9913128, 0xca7cf2b4191c8326,
+        0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,
+        0xf24a01a73cf2dccf, 0xbc633b39673c8cec,
+        0x976e41088617ca01, 0xd5be0503e085d813,
+        0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18,
+        0xec9c459d51852ba2, 0xddf8e7d60ed1219e,
+        0x93e1ab8252f33b45, 0xcabb90e5c942b503,
+        0xb8da1662e7b00a17, 0x3d6a751f3b936243,
+        0xe7109bfba19c0c9d, 0x0cc512670a783ad4,
+        0x906a617d450187e2, 0x27fb2b80668b24c5,
+        0xb484f9dc9641e9da, 0xb1f9f660802dedf6,
+        0xe1a63853bbd26451, 0x5e7873f8a0396973,
+        0x8d07e33455637eb2, 0xdb0b487b6423e1e8,
+        0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,
+        0xdc5c5301c56b75f7, 0x7641a140cc7810fb,
+        0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,
+        0xac2820d9623bf429, 0x546345fa9fbdcd44,
+        0xd732290fbacaf133, 0xa97c177947ad4095,
+        0x867f59a9d4bed6c0, 0x49ed8eabcccc485d,
+        0xa81f301449ee8c70, 0x5c68f256bfff5a74,
+        0xd226fc195c6a2f8c, 0x73832eec6fff3111,
+        0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,
+        0xa42e74f3d032f525, 0xba3e7ca8b77f5e55,
+        0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,
+        0x80444b5e7aa7cf85, 0x7980d163cf5b81b3,
+        0xa0555e361951c366, 0xd7e105bcc332621f,
+        0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7,
+        0xfa856334878fc150, 0xb14f98f6f0feb951,
+        0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3,
+        0xc3b8358109e84f07, 0x0a862f80ec4700c8,
+        0xf4a642e14c6262c8, 0xcd27bb612758c0fa,
+        0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,
+        0xbf21e44003acdd2c, 0xe0470a63e6bd56c3,
+        0xeeea5d5004981478, 0x1858ccfce06cac74,
+        0x95527a5202df0ccb, 0x0f37801e0c43ebc8,
+        0xbaa718e68396cffd, 0xd30560258f54e6ba,
+        0xe950df20247c83fd, 0x47c6b82ef32a2069,
+        0x91d28b7416cdd27e, 0x4cdc331d57fa5441,
+        0xb6472e511c81471d, 0xe0133fe4adf8e952,
+        0xe3d8f9e563a198e5, 0x58180fddd97723a6,
+        0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648,
+    };
+    return table;
+}
+
+// Binary mantissa (without the implicit bit) and biased exponent.
+// The exponent is negative if the result can not be decided.
+struct adjusted_mantissa {
+    uint64_t mantissa;
+    int32_t power2;
+
+    bool operator!=(const adjusted_mantissa& other) const {
+        return (mantissa != other.mantissa) | (power2 != other.power2);
+    }
+};
+
+// Eisel-Lemire: w * 10^q
+inline adjusted_mantissa eisel_lemire(const int64_t q, uint64_t w) {
+    adjusted_mantissa answer = { 0, 0 };
+    if ((w == 0) | (q < -342)) {
+        return answer;
+    }
+    if (q > 308) {
+        answer.power2 = 0x7FF;
+        return answer;
+    }
+    const uint32_t leadingZeros = clz(w);
+    w <<= leadingZeros;
+
+    const uint64_t* power = powers_of_five() + 2 * (q + 342);
+    uint128_t product = multiply(w, power[0]);
+    // 55 bits are needed: 52 + implicit + rounding + possible shift
+    const uint64_t precisionMask = 0xFFFFFFFFFFFFFFFFull >> 55;
+    if ((product.high & precisionMask) == precisionMask) {
+        const uint128_t second = multiply(w, power[1]);
+        product.low += second.high;
+        if (second.high > product.low) {
+            ++product.high;
+        }
+    }
+    if ((product.low == 0xFFFFFFFFFFFFFFFFull) & ((q < -27) | (q > 55))) {
+        answer.power2 = -1;
+        return answer;
+    }
+
+    const uint32_t upperBit = static_cast<uint32_t>(product.high >> 63);
+    const uint32_t shift = upperBit + 64 - 52 - 3;
+    answer.mantissa = product.high >> shift;
+    // floor(log2(10^q)) + 63 + upperBit - leadingZeros + bias
+    answer.power2 = static_cast<int32_t>(((((152170 + 65536) * q) >> 16) + 63)
+        + upperBit - leadingZeros + 1023);
+    if (answer.power2 <= 0) { // subnormal
+        if (-answer.power2 + 1 >= 64) {
+            answer.mantissa = 0;
+            answer.power2 = 0;
+            return answer;
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < (1ull << 52) ? 0 : 1;
+        return answer;
+    }
+    // Exactly halfway: round to even
+    if ((product.low <= 1) & (q >= -4) & (q <= 23) & ((answer.mantissa & 3) == 1)) {
+        if ((answer.mantissa << shift) == product.high) {
+            answer.mantissa &= ~1ull;
+        }
+    }
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (2ull << 52)) {
+        answer.mantissa = 1ull << 52;
+        ++answer.power2;
+    }
+    answer.mantissa &= ~(1ull << 52);
+    if (answer.power2 >= 0x7FF) {
+        answer.mantissa = 0;
+        answer.power2 = 0x7FF;
+    }
+    return answer;
+}
+
+// Arbitrary precision decimal for the slow path, digits are 0..9.
+struct big_decimal {
+    enum : int32_t {
+        max_digits = 800,
+        max_shift = 60,
+    };
+    uint8_t digits[max_digits];
+    int32_t count = 0; // number of digits
+    int32_t point = 0; // position of the decimal point
+    bool isTruncated = false; // nonzero digits are discarded
+
+    void trim() {
+        while ((count > 0) && (digits[count - 1] == 0)) {
+            --count;
+        }
+        if (count == 0) {
+            point = 0;
+        }
+    }
+    // Divides by 2^shift.
+    void shift_right(const uint32_t shift) {
+        int32_t read = 0;
+        int32_t write = 0;
+        uint64_t n = 0;
+        for (; (n >> shift) == 0; ++read) {
+            if (read >= count) {
+                if (n == 0) {
+                    count = 0;
+                    return;
+                }
+                while ((n >> shift) == 0) {
+                    n *= 10;
+                    ++read;
+                }
+                break;
+            }
+            n = n * 10 + digits[read];
+        }
+        point -= read - 1;
+        const uint64_t mask = (1ull << shift) - 1;
+        for (; read < count; ++read) {
+            digits[write++] = static_cast<uint8_t>(n >> shift);
+            n = (n & mask) * 10 + digits[read];
+        }
+        while (n > 0) {
+            const uint8_t digit = static_cast<uint8_t>(n >> shift);
+            if (write < max_digits) {
+                digits[write++] = digit;
+            }
+            else if (digit > 0) {
+                isTruncated = true;
+            }
+            n = (n & mask) * 10;
+        }
+        count = write;
+        trim();
+    }
+    // Multiplies by 2^shift.
+    void shift_left(const uint32_t shift) {
+        uint8_t result[max_digits + 20];
+        int32_t write = max_digits + 20;
+        uint64_t n = 0;
+        for (int32_t read = count - 1; read >= 0; --read) {
+            n += static_cast<uint64_t>(digits[read]) << shift;
+            result[--write] = static_cast<uint8_t>(n % 10);
+            n /= 10;
+        }
+        while (n > 0) {
+            result[--write] = static_cast<uint8_t>(n % 10);
+            n /= 10;
+        }
+        const int32_t added = max_digits + 20 - write - count;
+        count += added;
+        point += added;
+        if (count > max_digits) {
+            for (int32_t i = max_digits; i < count; ++i) {
+                if (result[write + i] != 0) {
+                    isTruncated = true;
+                }
+            }
+            count = max_digits;
+        }
+        std::memcpy(digits, result + write, count);
+        trim();
+    }
+    void shift_by(int32_t shift) {
+        if (count == 0) {
+            return;
+        }
+        for (; shift > max_shift; shift -= max_shift) {
+            shift_left(max_shift);
+        }
+        for (; shift < -max_shift; shift += max_shift) {
+            shift_right(max_shift);
+        }
+        if (shift > 0) {
+            shift_left(static_cast<uint32_t>(shift));
+        }
+        else if (shift < 0) {
+            shift_right(static_cast<uint32_t>(-shift));
+        }
+    }
+    bool should_round_up(const int32_t index) const {
+        if ((index < 0) | (index >= count)) {
+            return false;
+        }
+        if ((digits[index] == 5) & (index + 1 == count)) { // halfway
+            if (isTruncated) {
+                return true;
+            }
+            return (index > 0) && (digits[index - 1] % 2 == 1);
+        }
+        return digits[index] >= 5;
+    }
+    uint64_t rounded_integer() const {
+        if (point > 20) {
+            return 0xFFFFFFFFFFFFFFFFull;
+        }
+        uint64_t n = 0;
+        int32_t i = 0;
+        for (; (i < point) & (i < count); ++i) {
+            n = n * 10 + digits[i];
+        }
+        for (; i < point; ++i) {
+            n *= 10;
+        }
+        return n + should_round_up(point);
+    }
+    adjusted_mantissa to_double() {
+        adjusted_mantissa answer = { 0, 0 };
+        if (count == 0 || point < -330) {
+            return answer;
+        }
+        if (point > 310) {
+            answer.power2 = 0x7FF;
+            return answer;
+        }
+        static const uint8_t powers[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+        // Scale to [0.5, 1)
+        int32_t exponent = 0;
+        while (point > 0) {
+            const int32_t shift = point >= 9 ? 27 : powers[point];
+            shift_by(-shift);
+            exponent += shift;
+        }
+        while ((point < 0) || ((point == 0) && (digits[0] < 5))) {
+            const int32_t shift = -point >= 9 ? 27 : powers[-point];
+            shift_by(shift);
+            exponent -= shift;
+        }
+        --exponent; // [1, 2)
+        if (exponent < -1022) {
+            shift_by(exponent + 1022);
+            exponent = -1022;
+        }
+        if (exponent + 1023 >= 0x7FF) {
+            answer.power2 = 0x7FF;
+            return answer;
+        }
+        shift_by(53);
+        uint64_t mantissa = rounded_integer();
+        if (mantissa == (2ull << 52)) {
+            mantissa >>= 1;
+            ++exponent;
+            if (exponent + 1023 >= 0x7FF) {
+                answer.power2 = 0x7FF;
+                return answer;
+            }
+        }
+        answer.power2 = (mantissa & (1ull << 52)) ? exponent + 1023 : 0;
+        answer.mantissa = mantissa & ((1ull << 52) - 1);
+        return answer;
+    }
+};
+
+inline bool is_digit(const char c) {
+    return static_cast<uint8_t>(c - '0') < 10;
+}
+// All 8 bytes are '0'..'9'.
+inline bool is_eight_digits(const uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ull)
+        | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+// Converts 8 digits, the first one is in the lowest byte.
+inline uint32_t parse_eight_digits(uint64_t word) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    word -= 0x3030303030303030ull;
+    word = word * 10 + (word >> 8); // pairs
+    word = ((word & 0x000000FF000000FFull) * 0x000F424000000064ull
+        + ((word >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull) >> 32;
+    return static_cast<uint32_t>(word);
+}
+// Returns the first byte in [begin, end) that is not a digit, or `end`.
+inline const char* skip_digits(const char* begin, const char* end) {
+    for (; (end - begin >= 8) && is_eight_digits(load64(begin)); begin += 8) {}
+    for (; (begin < end) && is_digit(*begin); ++begin) {}
+    return begin;
+}
+// Classes of the characters of number tokens.
+struct char_class {
+    enum : uint8_t {
+        other,
+        digit,
+        sign, // `-`, `+`
+        float_mark, // `.`, `e`, `E`
+    };
+};
+template <typename = void>
+struct char_classes {
+    static const uint8_t table[256];
+};
+template <typename T>
+const uint8_t char_classes<T>::table[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x00
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x10
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 2, 3, 0, // 0x20
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, // 0x30
+    0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x40
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x50
+    0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x60
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x70
+    // 0x80 - 0xFF: other
+};
+inline uint8_t classify(const char c) {
+    return char_classes<>::table[static_cast<uint8_t>(c)];
+}
+// Finds the end of the number token at `begin`, a float has `.`, `e` or `E`.
+// The syntax is checked by the conversion.
+inline const char* scan_number(const char* begin, const char* end, bool& isFloat) {
+    isFloat = false;
+    for (++begin; begin < end; ++begin) {
+        const uint8_t type = classify(*begin);
+        if (type == char_class::digit) {
+            begin = skip_digits(begin + 1, end) - 1;
+        }
+        else if (type == char_class::float_mark) {
+            isFloat = true;
+        }
+        else if (type != char_class::sign) {
+            break;
+        }
+    }
+    return begin;
+}
+// Appends the digits from `begin` to `value`, wraps around on overflow.
+// Returns the first byte that is not a digit, or `end`.
+inline const char* parse_digits(const char* begin, const char* end, uint64_t& value) {
+    for (; end - begin >= 8; begin += 8) {
+        const uint64_t word = load64(begin);
+        if (!is_eight_digits(word)) {
+            break;
+        }
+        value = value * 100000000 + parse_eight_digits(word);
+    }
+    for (; (begin < end) && is_digit(*begin); ++begin) {
+        value = value * 10 + static_cast<uint8_t>(*begin - '0');
+    }
+    return begin;
+}
+
+// Parses `-?digits(.digits)?([eE][-+]?digits)?` from [begin, end).
+// Returns the end of the parsed part, or `begin` if there is no number.
+inline const char* parse_double(const char* begin, const char* end, double& value) {
+    const char* it = begin;
+    const bool isNegative = (it < end) && (*it == '-');
+    it += isNegative;
+    const char* digitsBegin = it;
+    uint64_t mantissa = 0;
+    it = parse_digits(it, end, mantissa);
+    const char* integerEnd = it;
+    int64_t digitCount = integerEnd - digitsBegin;
+    int64_t exponent = 0;
+    if ((it < end) && (*it == '.')) {
+        ++it;
+        const char* fractionBegin = it;
+        it = parse_digits(it, end, mantissa);
+        exponent = fractionBegin - it;
+        digitCount -= exponent;
+    }
+    if (digitCount == 0) {
+        return begin;
+    }
+    const char* digitsEnd = it;
+    int64_t exponentNumber = 0;
+    if ((it < end) && ((*it == 'e') | (*it == 'E'))) {
+        const char* exponentBegin = it;
+        ++it;
+        const bool isNegativeExponent = (it < end) && (*it == '-');
+        it += (it < end) && ((*it == '-') | (*it == '+'));
+        if ((it == end) || !is_digit(*it)) {
+            it = exponentBegin;
+        }
+        else {
+            for (; (it < end) && is_digit(*it); ++it) {
+                if (exponentNumber < 0x10000000) {
+                    exponentNumber = exponentNumber * 10 + static_cast<uint8_t>(*it - '0');
+                }
+            }
+            if (isNegativeExponent) {
+                exponentNumber = -exponentNumber;
+            }
+            exponent += exponentNumber;
+        }
+    }
+    const char* parsedEnd = it;
+
+    bool isTruncated = false;
+    if (digitCount > 19) {
+        // Leading zeros are not significant
+        for (const char* zeros = digitsBegin; zeros < digitsEnd; ++zeros) {
+            if (*zeros == '0') {
+                --digitCount;
+            }
+            else if (*zeros != '.') {
+                break;
+            }
+        }
+        if (digitCount > 19) {
+            // Keep the first 19 significant digits
+            isTruncated = true;
+            mantissa = 0;
+            it = digitsBegin;
+            while ((mantissa < 1000000000000000000ull) & (it < integerEnd)) {
+                mantissa = mantissa * 10 + static_cast<uint8_t>(*it - '0');
+                ++it;
+            }
+            if (mantissa >= 1000000000000000000ull) {
+                exponent = (integerEnd - it) + exponentNumber;
+            }
+            else {
+                const char* fractionBegin = ++it;
+                while ((mantissa < 1000000000000000000ull) & (it < digitsEnd)) {
+                    mantissa = mantissa * 10 + static_cast<uint8_t>(*it - '0');
+                    ++it;
+                }
+                exponent = (fractionBegin - it) + exponentNumber;
+            }
+        }
+    }
+
+    // Clinger's fast path, both operands and the result are exact doubles
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+    if (!isTruncated & (exponent >= -22) & (exponent <= 22) & (mantissa <= (1ull << 53))) {
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        value = static_cast<double>(mantissa);
+        if (exponent < 0) {
+            value /= powers[-exponent];
+        }
+        else {
+            value *= powers[exponent];
+        }
+        if (isNegative) {
+            value = -value;
+        }
+        return parsedEnd;
+    }
+#endif
+    adjusted_mantissa answer = eisel_lemire(exponent, mantissa);
+    if (isTruncated & (answer.power2 >= 0)) {
+        if (answer != eisel_lemire(exponent, mantissa + 1)) {
+            answer.power2 = -1;
+        }
+    }
+    if (answer.power2 < 0) {
+        big_decimal decimal;
+        bool isFraction = false;
+        for (it = digitsBegin; it < digitsEnd; ++it) {
+            if (*it == '.') {
+                isFraction = true;
+            }
+            else if ((*it == '0') & (decimal.count == 0)) {
+                decimal.point -= isFraction;
+            }
+            else {
+                if (decimal.count < big_decimal::max_digits) {
+                    decimal.digits[decimal.count++] = static_cast<uint8_t>(*it - '0');
+                }
+                else if (*it != '0') {
+                    decimal.isTruncated = true;
+                }
+                decimal.point += !isFraction;
+            }
+        }
+        decimal.point += static_cast<int32_t>(exponentNumber);
+        decimal.trim();
+        answer = decimal.to_double();
+    }
+    const uint64_t bits = answer.mantissa
+        | (static_cast<uint64_t>(answer.power2) << 52)
+        | (static_cast<uint64_t>(isNegative) << 63);
+    std::memcpy(&value, &bits, sizeof(value));
+    return parsedEnd;
+}
+
+// Converts `number` to an integer, a fraction is truncated. Returns false if
+// it is NaN or out of the range, then `value` is clamped to the range, NaN to 0.
+inline bool to_int64(const double number, int64_t& value) {
+    if (number >= 9223372036854775808.0) { // 2^63, exact unlike INT64_MAX
+        value = INT64_MAX;
+        return false;
+    }
+    if (number >= -9223372036854775808.0) {
+        value = static_cast<int64_t>(number);
+        return true;
+    }
+    value = number < 0.0 ? INT64_MIN : 0;
+    return false;
+}
+inline bool to_uint64(const double number, uint64_t& value) {
+    if (number >= 18446744073709551616.0) { // 2^64
+        value = UINT64_MAX;
+        return false;
+    }
+    if (number > -1.0) {
+        value = static_cast<uint64_t>(number);
+        return true;
+    }
+    value = 0;
+    return false;
+}
+inline bool to_int64(const uint64_t number, int64_t& value) {
+    value = number > INT64_MAX ? INT64_MAX : static_cast<int64_t>(number);
+    return number <= INT64_MAX;
+}
+inline bool to_uint64(const int64_t number, uint64_t& value) {
+    value = number < 0 ? 0 : static_cast<uint64_t>(number);
+    return number >= 0;
+}
+
+// Returns the closing `"` of a string, or `end`. `begin` is inside the string
+// and not after a `\`.
+inline const char* find_string_end(const char* begin, const char* end) {
+    for (;;) {
+        begin = find_quote_or_escape(begin, end);
+        if ((begin == end) || (*begin == '"')) {
+            return begin;
+        }
+        if (end - begin <= 2) {
+            return end;
+        }
+        begin += 2;
+    }
+}
+
+// Bytes of the simple escapes `\x`, 0 for `\u`. Unknown escapes keep
+// the byte, `\?` is the vertical tab written by json_writer.
+struct escape_table {
+    char bytes[256];
+
+    escape_table() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            bytes[i] = static_cast<char>(i);
+        }
+        bytes['b'] = '\b';
+        bytes['f'] = '\f';
+        bytes['n'] = '\n';
+        bytes['r'] = '\r';
+        bytes['t'] = '\t';
+        bytes['?'] = '\v';
+        bytes['u'] = 0;
+    }
+};
+// Returns the value of 4 hex digits, or a value above 0xFFFF.
+inline uint32_t parse_hex4(const char* begin) {
+    uint32_t code = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        const uint8_t c = static_cast<uint8_t>(begin[i]);
+        uint32_t digit = static_cast<uint8_t>(c - '0');
+        if (digit > 9) {
+            digit = static_cast<uint8_t>((c | 0x20) - 'a');
+            digit = digit < 6 ? digit + 10 : 0x10000;
+        }
+        code = (code << 4) | digit;
+    }
+    return code;
+}
+inline char* write_utf8(uint32_t code, char* out) {
+    if (code < 0x80) {
+        *out++ = static_cast<char>(code);
+    }
+    else if (code < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (code >> 6));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (code >> 12));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else {
+        *out++ = static_cast<char>(0xF0 | (code >> 18));
+        *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+// Checks a number token for RFC 8259, `-?(0|[1-9]digits)(.digits)?([eE][-+]?digits)?`.
+inline bool is_strict_number(const char* begin, const char* end) {
+    begin += *begin == '-';
+    if ((begin == end) || !is_digit(*begin)) {
+        return false;
+    }
+    begin = *begin == '0' ? begin + 1 : skip_digits(begin + 1, end);
+    if ((begin < end) && (*begin == '.')) {
+        if ((++begin == end) || !is_digit(*begin)) {
+            return false;
+        }
+        begin = skip_digits(begin + 1, end);
+    }
+    if ((begin < end) && ((*begin | 0x20) == 'e')) {
+        ++begin;
+        begin += (begin < end) && ((*begin == '-') | (*begin == '+'));
+        if ((begin == end) || !is_digit(*begin)) {
+            return false;
+        }
+        begin = skip_digits(begin + 1, end);
+    }
+    return begin == end;
+}
+// Returns the first escape that is not in RFC 8259 unless `isAnyEscapes`,
+// or the first byte below 0x20 unless `isControl`, in the string at `begin`.
+// Otherwise returns its closing `"`, or `end`.
+template <bool isAnyEscapes, bool isControl>
+inline const char* find_string_error(const char* begin, const char* end) {
+    for (; begin < end; ++begin) {
+        const uint8_t c = static_cast<uint8_t>(*begin);
+        if (c == '"') {
+            return begin;
+        }
+        if (!isControl & (c < 0x20)) {
+            return begin;
+        }
+        if (c != '\\') {
+            continue;
+        }
+        if (end - begin < 2) {
+            return end;
+        }
+        if (!isAnyEscapes) {
+            switch (begin[1]) {
+            case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                break;
+            case 'u':
+                if ((end - begin < 6) || (parse_hex4(begin + 2) > 0xFFFF)) {
+                    return begin;
+                }
+                break;
+            default:
+                return begin;
+            }
+        }
+        ++begin;
+    }
+    return end;
+}
+
+// Decodes the escape after a `\` at `begin` to `out`, never more bytes than
+// it reads. `\uXXXX` surrogate pairs become one UTF-8 sequence, a lone
+// surrogate becomes U+FFFD. Returns the last byte of the escape, or nullptr
+// if it is malformed.
+inline const char* unescape(const char* begin, const char* end, char*& out) {
+    static const escape_table table;
+    if (begin == end) {
+        return nullptr;
+    }
+    const char byte = table.bytes[static_cast<uint8_t>(*begin)];
+    if (byte != 0) {
+        *out++ = byte;
+        return begin;
+    }
+    if (end - begin < 5) {
+        return nullptr;
+    }
+    uint32_t code = parse_hex4(begin + 1);
+    if (code > 0xFFFF) {
+        return nullptr;
+    }
+    begin += 4;
+    if ((code & 0xF800) == 0xD800) {
+        const uint32_t low = (end - begin > 6) && (begin[1] == '\\') && (begin[2] == 'u')
+            ? parse_hex4(begin + 3) : 0;
+        if ((code < 0xDC00) & ((low & 0xFC00) == 0xDC00) & (low <= 0xFFFF)) {
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            begin += 6;
+        }
+        else {
+            code = 0xFFFD;
+        }
+    }
+    out = write_utf8(code, out);
+    return begin;
+}
+
+// Unescapes [begin, end) that has no closing `"`, in place.
+// Returns the new end, or nullptr if an escape is malformed.
+inline char* unescape_in_place(char* begin, char* end) {
+    char* out = const_cast<char*>(find_quote_or_escape(begin, end));
+    const char* it = out;
+    while (it < end) {
+        const char* last = unescape(it + 1, end, out);
+        if (last == nullptr) {
+            return nullptr;
+        }
+        const char* next = find_quote_or_escape(last + 1, end);
+        std::memmove(out, last + 1, next - (last + 1));
+        out += next - (last + 1);
+        it = next;
+    }
+    return out;
+}
+
+// Bump allocator for unescaped strings. The chunks are never moved or freed,
+// so released memory is reused without allocations by the next strings.
+struct scratch_arena {
+    struct mark_t {
+        size_t chunk;
+        size_t size;
+    };
+
+    mark_t mark() const {
+        return { current, used };
+    }
+    // Frees everything allocated after `mark`.
+    void release(const mark_t mark) {
+        current = mark.chunk;
+        used = mark.size;
+    }
+    void clear() {
+        release({ 0, 0 });
+    }
+    char* allocate(const size_t size) {
+        if (!chunks.empty() && (chunks[current].size() - used >= size)) {
+            char* ptr = chunks[current].data() + used;
+            used += size;
+            return ptr;
+        }
+        const size_t next = chunks.empty() ? 0 : current + 1;
+        if ((next == chunks.size()) || (chunks[next].size() < size)) {
+            size_t chunkSize = chunks.empty() ? 4096 : 2 * chunks.back().size();
+            if (chunkSize < size) {
+                chunkSize = size;
+            }
+            chunks.emplace(chunks.begin() + next, chunkSize);
+        }
+        current = next;
+        used = size;
+        return chunks[current].data();
+    }
+    size_t capacity() const {
+        size_t size = 0;
+        for (const auto& chunk : chunks) {
+            size += chunk.size();
+        }
+        return size;
+    }
+
+private:
+    std::vector<std::vector<char>> chunks;
+    size_t current = 0;
+    size_t used = 0;
+};
+
+#if defined(CJWD_STRING_TEMPLATE_ARGS)
+// A string literal as a template argument.
+template <size_t size>
+struct fixed_string {
+    char chars[size] = {};
+
+    constexpr fixed_string(const char (&string)[size]) {
+        for (size_t i = 0; i < size; ++i) {
+            chars[i] = string[i];
+        }
+    }
+    constexpr std::string_view view() const {
+        return std::string_view(chars, size - 1);
+    }
+};
+#endif
+} // namespace cjwd_detail
+
+
+// Read-only input file for json_reader, memory-mapped if `CJWD_MMAP` is
+// defined, otherwise read into memory. Strings from `reader = file.view()` stay
+// valid while it is open.
+struct json_file {
+    json_file() = default;
+    explicit json_file(const char* path) {
+        open(path);
+    }
+    json_file(const json_file&) = delete;
+    json_file& operator=(const json_file&) = delete;
+    ~json_file() {
+        close();
+    }
+
+    bool open(const char* path) {
+        close();
+#if defined(CJWD_NO_MMAP)
+        std::FILE* file = std::fopen(path, "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        char chunk[65536];
+        size_t count = 0;
+        while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            buffer.append(chunk, count);
+        }
+        const bool isError = std::ferror(file) != 0;
+        std::fclose(file);
+        if (isError) {
+            buffer.clear();
+            return false;
+        }
+        data = buffer.data();
+        size = buffer.size();
+#elif defined(_WIN32)
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        LARGE_INTEGER fileSize;
+        if ((file == INVALID_HANDLE_VALUE) || !GetFileSizeEx(file, &fileSize)) {
+            close();
+            return false;
+        }
+        size = static_cast<size_t>(fileSize.QuadPart);
+        data = "";
+        if (size > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            const void* view = mapping != nullptr
+                ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (view == nullptr) {
+                close();
+                return false;
+            }
+            data = static_cast<const char*>(view);
+        }
+#else
+        const int file = ::open(path, O_RDONLY);
+        struct stat status;
+        if ((file < 0) || (fstat(file, &status) != 0)) {
+            if (file >= 0) {
+                ::close(file);
+            }
+            return false;
+        }
+        size = static_cast<size_t>(status.st_size);
+        data = "";
+        if (size > 0) {
+            void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (view == MAP_FAILED) {
+                ::close(file);
+                size = 0;
+                data = nullptr;
+                return false;
+            }
+#   if defined(MADV_SEQUENTIAL)
+            madvise(view, size, MADV_SEQUENTIAL);
+#   endif
+            data = static_cast<const char*>(view);
+        }
+        ::close(file); // the mapping keeps the file
+#endif
+        return true;
+    }
+    void close() {
+#if defined(CJWD_NO_MMAP)
+        buffer = std::string();
+#elif defined(_WIN32)
+        if ((data != nullptr) && (size > 0)) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+            mapping = nullptr;
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if ((data != nullptr) && (size > 0)) {
+            munmap(const_cast<char*>(data), size);
+        }
+#endif
+        data = nullptr;
+        size = 0;
+    }
+    bool is_open() const {
+        return data != nullptr;
+    }
+    std::string_view view() const {
+        return std::string_view(data, size);
+    }
+
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#if defined(CJWD_NO_MMAP)
+    std::string buffer;
+#elif defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+namespace cjwd_detail {
+// Not constexpr, so a constexpr json_keys with these errors does not compile.
+inline void json_keys_duplicate_key() {}
+inline void json_keys_no_perfect_hash() {}
+} // namespace cjwd_detail
+
+// A set of keys for json_reader::parse(keys, handler), which calls the
+// handler with the number of the key in the set instead of the key, and
+// skips the values of other keys without calling it. A key is found by
+// a perfect hash and one comparison. The hash reads the length and the few
+// byte positions that tell the keys of the set apart, so different keys
+// always have different signatures. The keys are hashed into buckets, and
+// each bucket has a displacement that moves its keys to free slots. It is
+// built when the set is constructed, at compile time since C++14, where
+// a repeated key is a compile error:
+//     static constexpr json_keys<3> keys("name", "id", "email");
+template <uint32_t count>
+struct json_keys {
+    static_assert((count > 0) && (count < 0x8000), "unsupported number of keys");
+    static constexpr uint32_t npos = count;
+
+    template <typename... keys_t>
+    CJWD_CONSTEXPR14 json_keys(const keys_t&... keys) : names{ std::string_view(keys)... } {
+        static_assert(sizeof...(keys_t) == count, "the number of keys differs from `count`");
+        choose_positions();
+        // Small sets usually have a seed without collisions, then the
+        // displacements are not needed.
+        for (uint32_t attempt = 0; attempt < 64; ++attempt) {
+            if (build(true)) {
+                return;
+            }
+            seed = (seed * 0x2C1B3C6Du + 0x297A2D39u) | 1u; // odd for the multiplication
+        }
+        for (uint32_t attempt = 0; attempt < 16; ++attempt) {
+            if (build(false)) {
+                return;
+            }
+            seed = (seed * 0x2C1B3C6Du + 0x297A2D39u) | 1u; // odd for the multiplication
+        }
+        cjwd_detail::json_keys_no_perfect_hash();
+    }
+    // Returns the number of `key` in the set, or `npos`.
+    CJWD_CONSTEXPR14 uint32_t find(const std::string_view key) const {
+        const uint32_t h = hash(key);
+        const uint16_t index = slots[slot(h, isDirect ? 0 : displacements[bucket(h)])];
+        return (index != empty) && (names[index] == key) ? index : npos;
+    }
+    constexpr uint32_t size() const {
+        return count;
+    }
+    constexpr std::string_view operator[](const uint32_t index) const {
+        return names[index];
+    }
+
+private:
+    static constexpr uint32_t table_bits(const uint32_t bits = 1) {
+        return (1u << bits) >= 2 * count ? bits : table_bits(bits + 1);
+    }
+    static constexpr uint32_t tableBits = table_bits();
+    static constexpr uint32_t tableSize = 1u << tableBits;
+    static constexpr uint32_t bucketBits = tableBits - 1; // at least one bucket per key
+    static constexpr uint32_t bucketCount = 1u << bucketBits;
+    static constexpr uint16_t empty = 0xFFFF;
+
+    static constexpr uint8_t byte_at(const std::string_view key, const uint32_t position) {
+        return position < key.size() ? static_cast<uint8_t>(key[position]) : 0;
+    }
+    static constexpr uint32_t edges(const std::string_view key) {
+        return key.empty() ? 0 : static_cast<uint8_t>(key[0])
+            | (static_cast<uint32_t>(static_cast<uint8_t>(key[key.size() - 1])) << 8)
+            | (static_cast<uint32_t>(key.size()) << 16);
+    }
+    // Hashes the length, the first and last bytes, and the bytes at
+    // `positions`, which tell the rest of the keys apart.
+    CJWD_CONSTEXPR14 uint32_t hash(const std::string_view key) const {
+        uint32_t h = edges(key) * seed;
+        for (uint32_t i = 0; i < positionCount; ++i) {
+            h = (h ^ byte_at(key, positions[i])) * 0x01000193u;
+        }
+        return h ^ (h >> 16);
+    }
+    CJWD_CONSTEXPR14 bool is_same_signature(const std::string_view a, const std::string_view b) const {
+        if ((a.size() != b.size()) | (edges(a) != edges(b))) {
+            return false;
+        }
+        for (uint32_t i = 0; i < positionCount; ++i) {
+            if (byte_at(a, positions[i]) != byte_at(b, positions[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    // Adds the first differing position of two keys with the same signature
+    // until all the signatures differ, usually none or a few positions.
+    CJWD_CONSTEXPR14 void choose_positions() {
+        for (uint32_t k = 1; k < count; ++k) {
+            for (uint32_t j = 0; j < k; ++j) {
+                if (!is_same_signature(names[j], names[k])) {
+                    continue;
+                }
+                if (names[j] == names[k]) {
+                    cjwd_detail::json_keys_duplicate_key(); // the first one is found
+                    continue;
+                }
+                uint32_t position = 0;
+                while (names[j][position] == names[k][position]) {
+                    ++position;
+                }
+                positions[positionCount++] = static_cast<uint16_t>(position);
+                k = 0; // check all the pairs again
+                break;
+            }
+        }
+    }
+    static constexpr uint32_t bucket(const uint32_t h) {
+        return bucketBits == 0 ? 0 : (h * 0x2C1B3C6Du) >> (32 - bucketBits);
+    }
+    static constexpr uint32_t slot(const uint32_t h, const uint32_t displacement) {
+        return ((h ^ (displacement * 0x85EBCA6Bu)) * 0x9E3779B1u) >> (32 - tableBits);
+    }
+    // Returns false if two different keys have the same hash, or if
+    // `isDirect_` and two keys have the same slot.
+    CJWD_CONSTEXPR14 bool build(const bool isDirect_) {
+        isDirect = isDirect_;
+        for (uint32_t i = 0; i < tableSize; ++i) {
+            slots[i] = empty;
+        }
+        uint32_t hashes[count] = {};
+        uint32_t starts[bucketCount + 1] = {};
+        for (uint32_t index = 0; index < count; ++index) {
+            hashes[index] = hash(names[index]);
+            if (isDirect) {
+                const uint32_t s = slot(hashes[index], 0);
+                if ((slots[s] != empty) && (names[slots[s]] != names[index])) {
+                    return false;
+                }
+                if (slots[s] == empty) { // the first of repeated keys
+                    slots[s] = static_cast<uint16_t>(index);
+                }
+            }
+            ++starts[bucket(hashes[index]) + 1];
+        }
+        if (isDirect) {
+            return true;
+        }
+        uint32_t maxSize = 0;
+        for (uint32_t b = 0; b < bucketCount; ++b) {
+            maxSize = starts[b + 1] > maxSize ? starts[b + 1] : maxSize;
+            starts[b + 1] += starts[b];
+        }
+        // The keys grouped by buckets.
+        uint16_t order[count] = {};
+        uint32_t filled[bucketCount] = {};
+        for (uint32_t index = 0; index < count; ++index) {
+            const uint32_t b = bucket(hashes[index]);
+            order[starts[b] + filled[b]++] = static_cast<uint16_t>(index);
+        }
+        // Bigger buckets first, while most of the slots are free.
+        for (uint32_t size = maxSize; size > 0; --size) {
+            for (uint32_t b = 0; b < bucketCount; ++b) {
+                if ((starts[b + 1] - starts[b] == size) && !place(b, starts, order, hashes)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    // Finds a displacement that moves the keys of the bucket to free slots.
+    CJWD_CONSTEXPR14 bool place(const uint32_t b, const uint32_t (&starts)[bucketCount + 1],
+            uint16_t (&order)[count], const uint32_t (&hashes)[count]) {
+        const uint32_t first = starts[b];
+        uint32_t last = starts[b + 1];
+        for (uint32_t k = first + 1; k < last; ++k) {
+            for (uint32_t j = first; j < k; ++j) {
+                if (hashes[order[j]] != hashes[order[k]]) {
+                    continue;
+                }
+                if (names[order[j]] != names[order[k]]) {
+                    return false;
+                }
+                order[k--] = order[--last]; // a repeated key
+                break;
+            }
+        }
+        for (uint32_t displacement = 0; displacement <= 0xFFFF; ++displacement) {
+            bool isFree = true;
+            for (uint32_t k = first; isFree & (k < last); ++k) {
+                const uint32_t s = slot(hashes[order[k]], displacement);
+                isFree = slots[s] == empty;
+                for (uint32_t j = first; isFree & (j < k); ++j) {
+                    isFree = slot(hashes[order[j]], displacement) != s;
+                }
+            }
+            if (isFree) {
+                for (uint32_t k = first; k < last; ++k) {
+                    slots[slot(hashes[order[k]], displacement)] = order[k];
+                }
+                displacements[b] = static_cast<uint16_t>(displacement);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string_view names[count];
+    uint16_t slots[tableSize] = {};
+    uint16_t displacements[bucketCount] = {};
+    uint16_t positions[count] = {};
+    uint32_t positionCount = 0;
+    uint32_t seed = 0x9E3779B1u;
+    bool isDirect = false; // all the displacements are 0
+};
+#if defined(__cpp_deduction_guides)
+template <typename... keys_t>
+json_keys(const keys_t&...) -> json_keys<sizeof...(keys_t)>;
+#endif
+
+// A set of JSON Pointers (RFC 6901) for json_reader::parse(paths, handler),
+// where a `*` token matches any key or index: "/0/phones/1/number", "/*/id".
+// Paths are numbered in the order they are added. The set is compiled into
+// one tree without wildcards, so a key or index is matched once for all paths.
+struct json_paths {
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    json_paths() {
+        compile();
+    }
+    json_paths(std::initializer_list<std::string_view> paths) {
+        for (const std::string_view path : paths) {
+            add(path);
+        }
+        compile();
+    }
+    // Adds a path with the next number. Returns false if the path is not a
+    // JSON Pointer, it never matches then.
+    bool add(const std::string_view path) {
+        const uint32_t id = count++;
+        std::vector<std::string> tokens;
+        if (!split(path, tokens)) {
+            isValid = false;
+            return false;
+        }
+        uint32_t pattern = 0;
+        for (const std::string& token : tokens) {
+            pattern = add_pattern(pattern, token);
+        }
+        patterns[pattern].ids.push_back(id);
+        if (!isInitializing) {
+            compile();
+        }
+        return true;
+    }
+    uint32_t size() const {
+        return count;
+    }
+    // False if some of the paths are not JSON Pointers.
+    bool is_valid() const {
+        return isValid;
+    }
+
+private:
+    template <typename policy_t>
+    friend struct basic_json_reader;
+
+    // A node of the tree, `next` are the nodes of `keys`, `any` is for other keys.
+    struct node_t {
+        std::vector<std::string> keys;
+        std::vector<uint32_t> indices; // `keys` as array indices, or npos
+        std::vector<uint32_t> next;
+        uint32_t any = npos;
+        std::vector<uint32_t> ids; // paths that end here
+    };
+    // A node of the added paths, as they are, with wildcards.
+    struct pattern_t {
+        std::vector<std::pair<std::string, uint32_t>> children;
+        uint32_t any = npos;
+        std::vector<uint32_t> ids;
+    };
+
+    uint32_t next(const uint32_t node, const std::string_view key) const {
+        const node_t& from = nodes[node];
+        for (size_t i = 0; i < from.keys.size(); ++i) {
+            if (from.keys[i] == key) {
+                return from.next[i];
+            }
+        }
+        return from.any;
+    }
+    uint32_t next(const uint32_t node, const uint32_t index) const {
+        const node_t& from = nodes[node];
+        for (size_t i = 0; i < from.indices.size(); ++i) {
+            if (from.indices[i] == index) {
+                return from.next[i];
+            }
+        }
+        return from.any;
+    }
+    bool has_children(const uint32_t node) const {
+        return !nodes[node].keys.empty() || (nodes[node].any != npos);
+    }
+
+    // Splits "/a~1b/c" into "a/b" and "c", "" is the whole document.
+    static bool split(const std::string_view path, std::vector<std::string>& tokens) {
+        if (path.empty()) {
+            return true;
+        }
+        if (path[0] != '/') {
+            return false;
+        }
+        for (size_t i = 0; i < path.size(); ++i) {
+            const char c = path[i];
+            if (c == '/') {
+                tokens.emplace_back();
+            }
+            else if (c != '~') {
+                tokens.back() += c;
+            }
+            else if ((i + 1 < path.size()) && ((path[i + 1] == '0') | (path[i + 1] == '1'))) {
+                tokens.back() += path[++i] == '0' ? '~' : '/';
+            }
+            else {
+                return false;
+            }
+        }
+        return true;
+    }
+    // An array index has no leading zeros, "-" is never an index.
+    static uint32_t to_index(const std::string& token) {
+        if (token.empty() || (token.size() > 9) || ((token[0] == '0') & (token.size() > 1))) {
+            return npos;
+        }
+        uint32_t index = 0;
+        for (const char c : token) {
+            if ((c < '0') | (c > '9')) {
+                return npos;
+            }
+            index = index * 10 + (c - '0');
+        }
+        return index;
+    }
+    uint32_t add_pattern(const uint32_t parent, const std::string& token) {
+        if (token == "*") {
+            if (patterns[parent].any == npos) {
+                patterns[parent].any = static_cast<uint32_t>(patterns.size());
+                patterns.emplace_back();
+            }
+            return patterns[parent].any;
+        }
+        for (const auto& child : patterns[parent].children) {
+            if (child.first == token) {
+                return child.second;
+            }
+        }
+        const uint32_t child = static_cast<uint32_t>(patterns.size());
+        patterns[parent].children.emplace_back(token, child);
+        patterns.emplace_back();
+        return child;
+    }
+    // Builds the tree from the patterns, a node is a set of patterns that
+    // match the same path: a key leads to its children and to the wildcards.
+    void compile() {
+        isInitializing = false;
+        nodes.clear();
+        std::vector<std::vector<uint32_t>> sets(1, std::vector<uint32_t>(1, 0));
+        const auto find_or_add = [&sets](const std::vector<uint32_t>& set) -> uint32_t {
+            const auto found = std::find(sets.begin(), sets.end(), set);
+            if (found != sets.end()) {
+                return static_cast<uint32_t>(found - sets.begin());
+            }
+            sets.push_back(set);
+            return static_cast<uint32_t>(sets.size() - 1);
+        };
+        const auto insert = [](std::vector<uint32_t>& set, const uint32_t value) {
+            const auto at = std::lower_bound(set.begin(), set.end(), value);
+            if ((at == set.end()) || (*at != value)) {
+                set.insert(at, value);
+            }
+        };
+        for (size_t n = 0; n < sets.size(); ++n) {
+            const std::vector<uint32_t> set = sets[n]; // `sets` grows
+            node_t node;
+            std::vector<uint32_t> anySet;
+            for (const uint32_t pattern : set) {
+                for (const uint32_t id : patterns[pattern].ids) {
+                    insert(node.ids, id);
+                }
+                if (patterns[pattern].any != npos) {
+                    insert(anySet, patterns[pattern].any);
+                }
+            }
+            for (const uint32_t pattern : set) {
+                for (const auto& child : patterns[pattern].children) {
+                    if (std::find(node.keys.begin(), node.keys.end(), child.first) != node.keys.end()) {
+                        continue;
+                    }
+                    std::vector<uint32_t> target = anySet;
+                    for (const uint32_t other : set) {
+                        for (const auto& otherChild : patterns[other].children) {
+                            if (otherChild.first == child.first) {
+                                insert(target, otherChild.second);
+                            }
+                        }
+                    }
+                    node.keys.push_back(child.first);
+                    node.indices.push_back(to_index(child.first));
+                    node.next.push_back(find_or_add(target));
+                }
+            }
+            if (!anySet.empty()) {
+                node.any = find_or_add(anySet);
+            }
+            nodes.push_back(std::move(node));
+        }
+    }
+
+    std::vector<pattern_t> patterns = std::vector<pattern_t>(1); // the root is 0
+    std::vector<node_t> nodes;
+    uint32_t count = 0;
+    bool isValid = true;
+    bool isInitializing = true; // compile() once after the initializer list
+};
+
+namespace cjwd_detail {
+// Keys of the objects being parsed, for json_reader_policy::uniqueKeys.
+template <bool isEnabled>
+struct key_set {
+    struct scope_t {
+        explicit scope_t(key_set&) {}
+        bool insert(std::string_view) const {
+            return true;
+        }
+    };
+};
+template <>
+struct key_set<true> {
+    // The keys of the open objects, a hash table with linear probing over
+    // them. The keys of an object are removed in the reverse order when it
+    // is closed, so the probe sequences of the other keys stay intact.
+    struct slot_t {
+        uint32_t offset; // in `keys`
+        uint32_t size;
+        uint32_t scope; // the level of the object, 0 - an empty slot
+        uint32_t hash;
+    };
+    std::string keys;
+    std::vector<slot_t> slots;
+    std::vector<uint32_t> inserted; // the slots in the order of insertion
+    uint32_t scopes = 0;
+    // Varies with the address, so colliding keys can not be prepared.
+    uint64_t seed = reinterpret_cast<uintptr_t>(this) * 0x9E3779B97F4A7C15ull;
+
+    struct scope_t {
+        key_set& set;
+        const size_t keysMark;
+        const size_t insertedMark;
+        const uint32_t scope;
+
+        explicit scope_t(key_set& set_) : set(set_), keysMark(set_.keys.size()),
+            insertedMark(set_.inserted.size()), scope(++set_.scopes) {}
+        ~scope_t() {
+            for (size_t i = set.inserted.size(); i > insertedMark; --i) {
+                set.slots[set.inserted[i - 1]].scope = 0;
+            }
+            set.inserted.resize(insertedMark);
+            set.keys.resize(keysMark);
+            --set.scopes;
+        }
+        // Returns false if the object already has the key.
+        bool insert(const std::string_view key) {
+            if ((set.inserted.size() + 1) * 2 > set.slots.size()) {
+                set.grow();
+            }
+            const uint32_t hash = set.hash(key, scope);
+            const size_t mask = set.slots.size() - 1;
+            size_t index = hash & mask;
+            for (; set.slots[index].scope != 0; index = (index + 1) & mask) {
+                const slot_t& slot = set.slots[index];
+                if ((slot.hash == hash) & (slot.scope == scope) & (slot.size == key.size())
+                        && (std::memcmp(set.keys.data() + slot.offset, key.data(), key.size()) == 0)) {
+                    return false;
+                }
+            }
+            set.slots[index] = { static_cast<uint32_t>(set.keys.size()),
+                static_cast<uint32_t>(key.size()), scope, hash };
+            set.inserted.push_back(static_cast<uint32_t>(index));
+            set.keys.append(key.data(), key.size());
+            return true;
+        }
+    };
+
+private:
+    uint32_t hash(const std::string_view key, const uint32_t scope) const {
+        uint64_t hash = seed ^ (static_cast<uint64_t>(scope) << 32) ^ key.size();
+        const char* it = key.data();
+        const char* const end = key.data() + key.size();
+        for (; end - it >= 8; it += 8) {
+            hash = (hash ^ load64(it)) * 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 32;
+        }
+        for (; it < end; ++it) {
+            hash = (hash ^ static_cast<uint8_t>(*it)) * 0xC4CEB9FE1A85EC53ull;
+        }
+        hash ^= hash >> 29;
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+    // Doubles the table, the keys are inserted again in the same order.
+    void grow() {
+        std::vector<slot_t> old(slots.size() < 16 ? 32 : slots.size() * 2, slot_t{ 0, 0, 0, 0 });
+        old.swap(slots);
+        const size_t mask = slots.size() - 1;
+        for (uint32_t& at : inserted) {
+            const slot_t& slot = old[at];
+            size_t index = slot.hash & mask;
+            while (slots[index].scope != 0) {
+                index = (index + 1) & mask;
+            }
+            slots[index] = slot;
+            at = static_cast<uint32_t>(index);
+        }
+    }
+};
+} // namespace cjwd_detail
+
+// Compile-time features of basic_json_reader, a disabled feature is compiled
+// out of the parsing loops. Derive from it to change some of them.
+struct json_reader_policy {
+    static constexpr bool comments = true; // `// ...`, otherwise an error
+    static constexpr bool leadingPlus = true; // numbers like `+1`, otherwise an error
+    static constexpr bool decodeEscapes = true; // otherwise strings keep escapes as in the input
+    static constexpr bool uniqueKeys = false; // an error on a repeated key of an object
+    static constexpr bool looseCommas = true; // `[1 2]`, `[,1,,]`, `{"a":1,}`, otherwise an error
+    static constexpr bool looseNumbers = true; // `01`, `1.`, `-.5`, otherwise only RFC 8259 numbers
+    static constexpr bool anyEscapes = true; // `\q` is `q`, otherwise only RFC 8259 escapes
+    static constexpr bool controlCharacters = true; // raw bytes below 0x20 in strings, otherwise an error
+    static constexpr bool looseRoot = true; // any bytes around the root, `x[1]x`, otherwise only whitespace
+};
+// The syntax of RFC 8259 for objects, arrays, numbers and strings, and only
+// whitespace around the root, the next document of a sequence starts on a new
+// line. Skipped values are parsed to check them, so skipping is slower. The
+// encoding of strings is not checked, keys may repeat.
+struct json_strict_policy : json_reader_policy {
+    static constexpr bool comments = false;
+    static constexpr bool leadingPlus = false;
+    static constexpr bool looseCommas = false;
+    static constexpr bool looseNumbers = false;
+    static constexpr bool anyEscapes = false;
+    static constexpr bool controlCharacters = false;
+    static constexpr bool looseRoot = false;
+};
+
+struct json_cursor;
+struct json_push_reader;
+struct json_parallel_reader;
+
+// Values of basic_json_reader, the same for all policies.
+struct json_reader_types {
+    struct object_t {};
+    struct array_t {};
+    struct null_t {};
+    using key_t = std::string_view;
+    using scratch_t = cjwd_detail::scratch_arena; // can be shared by readers in one thread
+    enum idx : uint8_t {
+        number_idx, // a token with `.`, `e` or `E`, or out of 64-bit range
+        string_idx,
+        boolean_idx,
+        array_idx,
+        object_idx,
+        null_idx,
+        int64_idx, // an integer token, `-0` is 0 without the sign
+        uint64_idx, // an integer token above INT64_MAX
+        raw_number_idx, // any number token if `lazyNumbers`
+    };
+    // A number token that is converted on the first access. The token is
+    // checked when it is read, as parse_number() would check it.
+    struct raw_number_t {
+        std::string_view token;
+        bool isFloat = false; // has `.`, `e` or `E`
+
+        raw_number_t(const std::string_view token_, const bool isFloat_)
+            : token(token_), isFloat(isFloat_) {}
+        bool is_integer() const {
+            convert();
+            return cached != number_idx;
+        }
+        double as_number() const {
+            convert();
+            switch (cached) {
+            case int64_idx:
+                return static_cast<double>(static_cast<int64_t>(integer));
+            case uint64_idx:
+                return static_cast<double>(integer);
+            default:
+                return number;
+            }
+        }
+        int64_t as_int64() const {
+            int64_t value = 0;
+            try_as_int64(value);
+            return value;
+        }
+        uint64_t as_uint64() const {
+            uint64_t value = 0;
+            try_as_uint64(value);
+            return value;
+        }
+        bool try_as_int64(int64_t& value) const {
+            convert();
+            switch (cached) {
+            case int64_idx:
+                value = static_cast<int64_t>(integer);
+                return true;
+            case uint64_idx:
+                return cjwd_detail::to_int64(integer, value);
+            default:
+                return cjwd_detail::to_int64(number, value);
+            }
+        }
+        bool try_as_uint64(uint64_t& value) const {
+            convert();
+            switch (cached) {
+            case int64_idx:
+                return cjwd_detail::to_uint64(static_cast<int64_t>(integer), value);
+            case uint64_idx:
+                value = integer;
+                return true;
+            default:
+                return cjwd_detail::to_uint64(number, value);
+            }
+        }
+    private:
+        void convert() const {
+            if (isCached) {
+                return;
+            }
+            isCached = true;
+            value_t value;
+            if (parse_number(token.data(), token.data() + token.size(), isFloat, value) != nullptr) {
+                cached = number_idx;
+                number = std::nan("");
+                return;
+            }
+            cached = static_cast<uint8_t>(value.index());
+            switch (value.index()) {
+            case int64_idx:
+                integer = static_cast<uint64_t>(std::get<int64_idx>(value));
+                break;
+            case uint64_idx:
+                integer = std::get<uint64_idx>(value);
+                break;
+            default:
+                number = std::get<number_idx>(value);
+                break;
+            }
+        }
+        mutable bool isCached = false;
+        mutable uint8_t cached = number_idx;
+        mutable double number = 0.0;
+        mutable uint64_t integer = 0;
+    };
+    struct value_t : public std::variant<
+            double, std::string_view, bool, array_t, object_t, null_t, int64_t, uint64_t,
+            raw_number_t> {
+        bool is_number() const {
+            return (index() == number_idx) | (index() == int64_idx)
+                | (index() == uint64_idx) | (index() == raw_number_idx);
+        }
+        double as_number() const {
+            switch (index()) {
+            case int64_idx:
+                return static_cast<double>(std::get<int64_idx>(*this));
+            case uint64_idx:
+                return static_cast<double>(std::get<uint64_idx>(*this));
+            case raw_number_idx:
+                return std::get<raw_number_idx>(*this).as_number();
+            default:
+                return std::get<number_idx>(*this);
+            }
+        }
+        bool is_integer() const {
+            switch (index()) {
+            case int64_idx:
+            case uint64_idx:
+                return true;
+            case raw_number_idx:
+                return std::get<raw_number_idx>(*this).is_integer();
+            default:
+                return false;
+            }
+        }
+        // Out of range values, such as `1e30` or `-1` for as_uint64(), are
+        // clamped to the range, NaN is 0, a fraction is truncated.
+        int64_t as_int64() const {
+            int64_t value = 0;
+            try_as_int64(value);
+            return value;
+        }
+        uint64_t as_uint64() const {
+            uint64_t value = 0;
+            try_as_uint64(value);
+            return value;
+        }
+        // Returns false if the number does not fit, `value` is clamped then.
+        bool try_as_int64(int64_t& value) const {
+            switch (index()) {
+            case int64_idx:
+                value = std::get<int64_idx>(*this);
+                return true;
+            case uint64_idx:
+                return cjwd_detail::to_int64(std::get<uint64_idx>(*this), value);
+            case raw_number_idx:
+                return std::get<raw_number_idx>(*this).try_as_int64(value);
+            default:
+                return cjwd_detail::to_int64(std::get<number_idx>(*this), value);
+            }
+        }
+        bool try_as_uint64(uint64_t& value) const {
+            switch (index()) {
+            case int64_idx:
+                return cjwd_detail::to_uint64(std::get<int64_idx>(*this), value);
+            case uint64_idx:
+                value = std::get<uint64_idx>(*this);
+                return true;
+            case raw_number_idx:
+                return std::get<raw_number_idx>(*this).try_as_uint64(value);
+            default:
+                return cjwd_detail::to_uint64(std::get<number_idx>(*this), value);
+            }
+        }
+        // The source token of a number if `lazyNumbers`, lossless.
+        std::string_view as_raw_number() const {
+            return std::get<raw_number_idx>(*this).token;
+        }
+        bool is_string() const {
+            return index() == string_idx;
+        }
+        const std::string_view as_string() const {
+            return std::get<string_idx>(*this);
+        }
+        bool is_boolean() const {
+            return index() == boolean_idx;
+        }
+        bool as_boolean() const {
+            return std::get<boolean_idx>(*this);
+        }
+        bool is_array() const {
+            return index() == array_idx;
+        }
+        bool is_object() const {
+            return index() == object_idx;
+        }
+        bool is_null() const {
+            return index() == null_idx;
+        }
+    };
+
+private:
+    template <typename policy_t>
+    friend struct basic_json_reader;
+    friend struct json_push_reader;
+    friend struct json_cursor;
+
+    // Converts a number token, integer tokens are exact if they fit 64 bits.
+    // Returns the position of an error or nullptr.
+    static const char* parse_number(const char* begin, const char* end,
+            const bool isFloat, value_t& value) {
+        const bool isNegative = *begin == '-';
+        const char* digits = begin + (isNegative | (*begin == '+'));
+        const size_t count = static_cast<size_t>(end - digits);
+        if (!isFloat & (count - 1 < 20)) {
+            const char* last = count == 20 ? end - 1 : end;
+            uint64_t integer = 0;
+            digits = cjwd_detail::parse_digits(digits, last, integer);
+            if (digits != last) {
+                return digits;
+            }
+            bool isOverflow = false;
+            if (count == 20) {
+                const uint8_t digit = static_cast<uint8_t>(*digits - '0');
+                if (digit > 9) {
+                    return digits;
+                }
+                // UINT64_MAX == 18446744073709551615
+                isOverflow = (integer > 1844674407370955161ull)
+                    | ((integer == 1844674407370955161ull) & (digit > 5));
+                integer = integer * 10 + digit;
+            }
+            if (!isOverflow & !isNegative) {
+                if (integer <= 9223372036854775807ull) {
+                    value.emplace<int64_idx>(static_cast<int64_t>(integer));
+                }
+                else {
+                    value.emplace<uint64_idx>(integer);
+                }
+                return nullptr;
+            }
+            if (!isOverflow & (integer <= 9223372036854775808ull)) {
+                value.emplace<int64_idx>(static_cast<int64_t>(0 - integer));
+                return nullptr;
+            }
+        }
+        const char* number = begin + (*begin == '+');
+        if ((number != begin) && (number < end) && (*number == '-')) { // `+-`
+            return number;
+        }
+        double v = 0.0;
+        const char* parsed = cjwd_detail::parse_double(number, end, v);
+        if (parsed == number) { // no digits
+            return begin;
+        }
+        if (parsed != end) {
+            return parsed;
+        }
+        value.emplace<number_idx>(v);
+        return nullptr;
+    }
+    // Returns the error that parse_number() reports for the token, or
+    // nullptr, without the conversion.
+    static const char* find_number_error(const char* begin, const char* end, const bool isFloat) {
+        const char* digits = begin + ((*begin == '-') | (*begin == '+'));
+        if (!isFloat & (static_cast<size_t>(end - digits) - 1 < 20)) {
+            digits = cjwd_detail::skip_digits(digits, end);
+            return digits != end ? digits : nullptr;
+        }
+        // As cjwd_detail::parse_double
+        const char* it = begin + ((*begin == '-') | (*begin == '+'));
+        if ((*begin == '+') && (it < end) && (*it == '-')) {
+            return it;
+        }
+        const char* integerEnd = cjwd_detail::skip_digits(it, end);
+        bool hasDigits = integerEnd != it;
+        it = integerEnd;
+        if ((it < end) && (*it == '.')) {
+            const char* fractionBegin = ++it;
+            it = cjwd_detail::skip_digits(it, end);
+            hasDigits |= it != fractionBegin;
+        }
+        if (!hasDigits) {
+            return begin;
+        }
+        if ((it < end) && ((*it == 'e') | (*it == 'E'))) {
+            const char* exponentBegin = it++;
+            it += (it < end) && ((*it == '-') | (*it == '+'));
+            it = (it < end) && cjwd_detail::is_digit(*it)
+                ? cjwd_detail::skip_digits(it + 1, end) : exponentBegin;
+        }
+        return it != end ? it : nullptr;
+    }
+    // Finds the end of a number token as cjwd_detail::scan_number() does and
+    // checks it in the same pass, for raw tokens of lazyNumbers. `errorAt` is
+    // the error of find_number_error() or nullptr.
+    static const char* scan_raw_number(const char* begin, const char* end,
+            bool& isFloat, const char*& errorAt) {
+        const char* it = begin + ((*begin == '-') | (*begin == '+'));
+        const char* digits = it;
+        it = cjwd_detail::skip_digits(it, end);
+        bool hasDigits = it != digits;
+        isFloat = false;
+        if ((it < end) && (*it == '.')) {
+            isFloat = true;
+            digits = ++it;
+            it = cjwd_detail::skip_digits(it, end);
+            hasDigits |= it != digits;
+        }
+        if ((it < end) && ((*it == 'e') | (*it == 'E'))) {
+            isFloat = true;
+            ++it;
+            it += (it < end) && ((*it == '-') | (*it == '+'));
+            digits = it;
+            it = cjwd_detail::skip_digits(it, end);
+            hasDigits &= it != digits;
+        }
+        errorAt = nullptr;
+        if (hasDigits && ((it == end) || (cjwd_detail::classify(*it) == cjwd_detail::char_class::other))) {
+            return it;
+        }
+        const char* tokenEnd = cjwd_detail::scan_number(begin, end, isFloat);
+        errorAt = find_number_error(begin, tokenEnd, isFloat);
+        return tokenEnd;
+    }
+};
+
+template <typename policy_t = json_reader_policy>
+struct basic_json_reader : json_reader_types {
     const char* begin = nullptr;
     const char* end = nullptr; // begin + size
     const char* error = nullptr; // check after parse
     uint8_t rootType = 0; // 1 - object, 2 - array
+    bool lazyNumbers = false; // convert numbers on access, see raw_number_t
+    cjwd_detail::scratch_arena* scratch = nullptr; // unescaped strings, internal if nullptr
+    // Two-stage parsing: the assignment indexes structural characters of the
+    // whole input with SIMD, then handlers are driven from the index, without
+    // visiting whitespace and strings byte by byte. The same handlers and
+    // results, a number or literal must end at whitespace or a structural
+    // character in both modes. Inputs with comments or backslashes outside
+    // strings are parsed in the normal mode.
+    bool structuralIndex = false;
+
+    void operator=(const std::string_view json) {
+        begin = json.data();
+        end = json.data() + json.size();
+        isMutable = false;
+        isTape = structuralIndex && tape.build(begin, end);
+        tapeBase = begin;
+        tapeEnd = end;
+        tapeIndex = 0;
+        find_document();
+    }
+    // Moves to the next document of a sequence, such as JSON Lines, whether
+    // the current one was parsed, skipped or not touched. After an error it
+    // continues from the next line. Returns false at the end of the input.
+    bool next_document() {
+        if (rootType == 0) {
+            return false;
+        }
+        if (error != nullptr) {
+            const void* newline = std::memchr(error, '\n', end - error);
+            begin = newline != nullptr ? static_cast<const char*>(newline) : end;
+        }
+        else if (isStopped) {
+            isStopped = false;
+            begin = documentBegin;
+            skip();
+        }
+        else if (begin == documentBegin) {
+            skip();
+        }
+        if (begin < end) {
+            ++begin; // after `}`, `]` or `\n`
+        }
+        find_document();
+        if (rootType == 0) {
+            if (begin == end) {
+                error = nullptr;
+            }
+            return false;
+        }
+        return true;
+    }
+    // Destructive mode: escaped strings are unescaped over the input, so all
+    // strings point into `json` and nothing is allocated. The input can not be
+    // parsed again.
+    void assign_mutable(char* json, const size_t size) {
+        *this = std::string_view(json, size);
+        isMutable = true;
+    }
+
+    bool is_object() const {
+        return rootType == 1;
+    }
+    bool is_array() const {
+        return rootType == 2;
+    }
+
+private:
+    template <typename arg_t, typename handler_t>
+    struct is_handler {
+        template <typename T>
+        static auto check(int) -> decltype(std::declval<T&>()(
+            std::declval<arg_t>(), std::declval<const value_t&>()), std::true_type());
+        template <typename T>
+        static std::false_type check(...);
+        static constexpr bool value = decltype(check<handler_t>(0))::value;
+    };
+    template <typename handler_t>
+    using is_object_handler = is_handler<key_t,
+        typename std::remove_reference<handler_t>::type>;
+    template <typename handler_t>
+    using is_array_handler = is_handler<uint32_t,
+        typename std::remove_reference<handler_t>::type>;
+
+    struct skip_t {
+        template <typename arg_t>
+        void operator()(arg_t, const value_t&) const {}
+    };
+    template <typename handler_t>
+    static auto has_handler(const handler_t& handler, int) -> decltype(static_cast<bool>(handler)) {
+        return static_cast<bool>(handler);
+    }
+    template <typename handler_t>
+    static bool has_handler(const handler_t&, long) {
+        return true;
+    }
+    static bool has_handler(const skip_t&, int) {
+        return false;
+    }
+    template <typename handler_t>
+    struct paths_handler_t {
+        basic_json_reader& reader;
+        const json_paths& paths;
+        const uint32_t node;
+        handler_t& handler;
+
+        template <typename id_t>
+        void operator()(const id_t id, const value_t& value) {
+            const uint32_t next = paths.next(node, id);
+            if (next != json_paths::npos) {
+                reader.parse_path(paths, next, value, handler);
+            }
+        }
+    };
+    template <typename handler_t>
+    void parse_path(const json_paths& paths, const uint32_t node, const value_t& value, handler_t& handler) {
+        const char* beginBefore = begin;
+        for (const uint32_t id : paths.nodes[node].ids) {
+            handler(id, value);
+            if ((error != nullptr) | isStopped) {
+                return;
+            }
+        }
+        if ((begin != beginBefore) || !paths.has_children(node)) {
+            return;
+        }
+        paths_handler_t<handler_t> pathsHandler{ *this, paths, node, handler };
+        if (value.is_object()) {
+            parse_object(pathsHandler);
+        }
+        else if (value.is_array()) {
+            parse_array(pathsHandler);
+        }
+    }
+    template <uint32_t count, typename handler_t>
+    struct keys_handler_t {
+        const json_keys<count>& keys;
+        handler_t& handler;
+
+        explicit operator bool() const {
+            return has_handler(handler, 0);
+        }
+        void operator()(const key_t key, const value_t& value) {
+            const uint32_t index = keys.find(key);
+            if (index != json_keys<count>::npos) {
+                handler(index, value);
+            }
+        }
+    };
+
+public:
+    // Handlers with a static type (lambdas, functors) are inlined into the parser.
+    template <typename handler_t, typename std::enable_if<
+        is_object_handler<handler_t>::value, int>::type = 0>
+    void parse(handler_t&& handler) {
+        parse_object(handler);
+    }
+    template <typename handler_t, typename std::enable_if<
+        is_array_handler<handler_t>::value, int>::type = 0>
+    void parse(handler_t&& handler) {
+        parse_array(handler);
+    }
+    // Type-erased handlers. An empty `std::function` skips the value.
+    void parse(std::function<void(key_t key, const value_t& value)> handler) {
+        parse_object(handler);
+    }
+    void parse(std::function<void(uint32_t index, const value_t& value)> handler) {
+        parse_array(handler);
+    }
+    // Parses an object with handler(uint32_t key, const value_t& value), where
+    // `key` is the number of the key in `keys`. The values of other keys are
+    // skipped without calling the handler.
+    template <uint32_t count, typename handler_t>
+    void parse(const json_keys<count>& keys, handler_t&& handler) {
+        keys_handler_t<count, typename std::remove_reference<handler_t>::type> keysHandler{ keys, handler };
+        parse_object(keysHandler);
+    }
+    // Calls handler(uint32_t path, const value_t& value) for the values at
+    // `paths`, in the document order. Only the branches that lead to them are
+    // parsed, the rest is skipped. A matched object or array is still entered
+    // for longer paths unless the handler parses or skips it.
+    template <typename handler_t>
+    void parse(const json_paths& paths, handler_t&& handler) {
+        if (error != nullptr) {
+            return;
+        }
+        value_t value;
+        if (is_object()) {
+            value.emplace<object_idx>();
+        }
+        else if (is_array()) {
+            value.emplace<array_idx>();
+        }
+        else {
+            return;
+        }
+        parse_path(paths, 0, value, handler);
+    }
+#if defined(CJWD_STRING_TEMPLATE_ARGS)
+    // The same with the keys as template arguments: parse<"name", "id">(handler).
+    template <cjwd_detail::fixed_string... keys, typename handler_t>
+        requires (sizeof...(keys) > 0)
+    void parse(handler_t&& handler) {
+        static constexpr json_keys<sizeof...(keys)> staticKeys(keys.view()...);
+        parse(staticKeys, handler);
+    }
+#endif
+    // Skips an object or array value instead of parsing it, without calling
+    // any handler. Only brackets, strings and comments are tracked.
+    void skip() {
+        if ((error != nullptr) | isStopped) {
+            return;
+        }
+        if (isSkipChecked) {
+            skip_t skipHandler;
+            if (begin[-1] == '{') {
+                parse_object(skipHandler);
+            }
+            else {
+                parse_array(skipHandler);
+            }
+            return;
+        }
+        if (is_tape() && enter_tape()) {
+            skip_tape_entries();
+            return;
+        }
+        cjwd_detail::skip_state state;
+        begin = cjwd_detail::skip_container(begin, end, state);
+        if (begin == end) { // the input ends before the closing bracket
+            error = begin;
+        }
+    }
+    // Stops parsing from a handler: the current and all enclosing parse()
+    // calls return at once, the rest of the document is not read. `error`
+    // stays nullptr, `begin` stays at the value of the handler.
+    void stop() {
+        isStopped = true;
+    }
+    // Whether parse() has returned because of stop(), until the next document.
+    bool is_stopped() const {
+        return isStopped;
+    }
+
+private:
+    scratch_t ownScratch;
+    bool isMutable = false; // see assign_mutable
+    bool isStopped = false; // see stop
+    using key_set_t = cjwd_detail::key_set<policy_t::uniqueKeys>;
+    key_set_t keySet; // see json_reader_policy::uniqueKeys
+    const char* documentBegin = nullptr; // after the root `{` or `[`
+
+    friend struct json_parallel_reader;
+    // Sets the reader to the elements of an array after its `[`, for a part
+    // of the array parsed by json_parallel_reader.
+    void reset_array(const char* begin_, const char* end_) {
+        begin = begin_;
+        end = end_;
+        error = nullptr;
+        isStopped = false;
+        isMutable = false;
+        isTape = false;
+        rootType = 2;
+        documentBegin = begin_;
+    }
+    void find_document() {
+        error = nullptr;
+        isStopped = false;
+        rootType = 0;
+        while (begin < end) {
+            switch (*begin++) {
+            case '{':
+                rootType = 1;
+                documentBegin = begin;
+                return;
+            case '[':
+                rootType = 2;
+                documentBegin = begin;
+                return;
+            default:
+                if (!policy_t::looseRoot && !cjwd_detail::is_whitespace(begin[-1])) {
+                    error = --begin;
+                    return;
+                }
+                break;
+            }
+        }
+        error = begin;
+    }
+    // Checks the bytes after the root without looseRoot, when the root
+    // object or array is parsed or skipped.
+    struct root_scope {
+        basic_json_reader& reader;
+        const bool isRoot;
+
+        explicit root_scope(basic_json_reader& reader_)
+            : reader(reader_), isRoot(!policy_t::looseRoot && (reader_.begin == reader_.documentBegin)) {}
+        ~root_scope() {
+            if (isRoot) {
+                reader.check_root_end();
+            }
+        }
+    };
+    // Whitespace may follow the closing bracket of the root, and a newline
+    // with the next document.
+    void check_root_end() {
+        if ((error != nullptr) | isStopped) {
+            return;
+        }
+        const char* at = cjwd_detail::skip_whitespace(begin + 1, end);
+        if ((at != end) && (((*at != '{') & (*at != '['))
+                || (std::memchr(begin + 1, '\n', at - (begin + 1)) == nullptr))) {
+            error = at;
+        }
+    }
+
+    scratch_t& get_scratch() {
+        return scratch != nullptr ? *scratch : ownScratch;
+    }
+    // Frees the strings of a nesting level on return.
+    struct scratch_scope {
+        scratch_t& arena;
+        const scratch_t::mark_t mark;
+
+        explicit scratch_scope(scratch_t& arena_) : arena(arena_), mark(arena_.mark()) {}
+        ~scratch_scope() {
+            arena.release(mark);
+        }
+    };
+    // Starts an unescaped copy of the string [beginStr, closing `"`),
+    // `escape` is its first `\`. The copy fits as unescaping only shrinks,
+    // and in the mutable mode it trails the read position in place.
+    char* begin_unescaped(const char* beginStr, const char* escape) {
+        if (isMutable) {
+            return const_cast<char*>(escape);
+        }
+        const char* endStr = cjwd_detail::find_string_end(escape, end);
+        char* out = get_scratch().allocate(endStr - beginStr);
+        std::memcpy(out, beginStr, escape - beginStr);
+        return out + (escape - beginStr);
+    }
+
+    cjwd_detail::tape_t tape;
+    const char* tapeBase = nullptr;
+    const char* tapeEnd = nullptr;
+    uint32_t tapeIndex = 0; // the first entry at or after `begin`
+    bool isTape = false; // see structuralIndex
+
+    bool is_tape() const {
+        return isTape & (end == tapeEnd);
+    }
+    const char* tape_at(const uint32_t entry) const {
+        return tapeBase + tape.offset(entry);
+    }
+    // Finds the entry of `begin` if it was moved without the tape.
+    void sync_tape() {
+        const uint32_t offset = static_cast<uint32_t>(begin - tapeBase);
+        if ((tapeIndex < tape.size) && (tape.offset(tapeIndex) >= offset)
+                && ((tapeIndex == 0) || (tape.offset(tapeIndex - 1) < offset))) {
+            return;
+        }
+        uint32_t first = 0;
+        uint32_t count = tape.size;
+        while (count > 0) {
+            const uint32_t half = count / 2;
+            if (tape.offset(first + half) < offset) {
+                first += half + 1;
+                count -= half + 1;
+            }
+            else {
+                count = half;
+            }
+        }
+        tapeIndex = first;
+    }
+    // Checks that the bracket before `begin` is an entry, it is not if
+    // find_document() has stopped inside a string of a broken document.
+    bool enter_tape() {
+        sync_tape();
+        return (tapeIndex != 0) && (tape_at(tapeIndex - 1) + 1 == begin);
+    }
+    // Moves to the bracket that closes the container opened before the
+    // current entry, or to the end.
+    void skip_tape_entries() {
+        uint32_t depth = 1;
+        for (; tapeIndex < tape.size; ++tapeIndex) {
+            const char c = *tape_at(tapeIndex);
+            depth += (c == '{') | (c == '[');
+            depth -= (c == '}') | (c == ']');
+            if (depth == 0) {
+                begin = tape_at(tapeIndex);
+                return;
+            }
+        }
+        begin = end;
+        error = end;
+    }
+    // A policy that rejects any syntax or repeated keys parses skipped values
+    // to check them.
+    static constexpr bool isSkipChecked = !policy_t::comments | !policy_t::leadingPlus
+        | !policy_t::looseCommas | !policy_t::looseNumbers | !policy_t::anyEscapes
+        | !policy_t::controlCharacters | policy_t::uniqueKeys;
+    // Keys are compared decoded, also in skipped objects.
+    static constexpr bool isSkippedKeyDecoded = policy_t::uniqueKeys & policy_t::decodeEscapes;
+    struct commas_t {
+        bool hasEntry = false;
+        bool isAfterComma = false;
+    };
+    // Checks the commas of an object or array at `at` without looseCommas:
+    // no leading, repeated, trailing or missing ones.
+    bool check_commas(const char* at, commas_t& commas) {
+        switch (*at) {
+        case ' ': case '\t': case '\r': case '\n': case '/':
+            return true;
+        case ',':
+            if (!commas.hasEntry | commas.isAfterComma) {
+                break;
+            }
+            commas.isAfterComma = true;
+            return true;
+        case '}': case ']':
+            if (commas.isAfterComma) {
+                break;
+            }
+            return true;
+        default:
+            if (commas.hasEntry & !commas.isAfterComma) {
+                break;
+            }
+            commas.hasEntry = true;
+            commas.isAfterComma = false;
+            return true;
+        }
+        error = at;
+        return false;
+    }
+    // Checks the number token [at, tokenEnd) without looseNumbers.
+    bool check_number(const char* at, const char* tokenEnd) {
+        if (!policy_t::looseNumbers && !cjwd_detail::is_strict_number(at, tokenEnd)) {
+            error = at;
+            return false;
+        }
+        return true;
+    }
+
+    // Checks the string at `beginStr` before it is decoded, without anyEscapes
+    // or controlCharacters. A string without the closing `"` is not an error here.
+    bool check_string(const char* beginStr) {
+        if (policy_t::anyEscapes & policy_t::controlCharacters) {
+            return true;
+        }
+        const char* at = cjwd_detail::find_string_error<policy_t::anyEscapes,
+            policy_t::controlCharacters>(beginStr, end);
+        if ((at != end) && (*at != '"')) {
+            error = at;
+            return false;
+        }
+        return true;
+    }
+    // A token must be followed by whitespace or the next entry,
+    // like `1x` or `truex` are not.
+    bool check_token_end(const char* tokenEnd) {
+        if ((tokenEnd < end) && !cjwd_detail::is_whitespace(*tokenEnd)
+                && ((tapeIndex >= tape.size) || (tape_at(tapeIndex) != tokenEnd))) {
+            error = tokenEnd;
+            return false;
+        }
+        return true;
+    }
+    // The same for a number or literal of the normal mode, so `[1null]` and
+    // `[true1]` are errors in both modes.
+    bool check_scalar_end(const char* tokenEnd) {
+        if ((tokenEnd < end) && !cjwd_detail::is_token_end(*tokenEnd)) {
+            error = tokenEnd;
+            return false;
+        }
+        return true;
+    }
+    // Reads the string of the opening quote entry, which is followed by the
+    // closing quote entry. Escapes are decoded only if `isDecode`.
+    bool read_tape_string(const bool isDecode, std::string_view& result) {
+        const bool isEscaped = (tape.offsets[tapeIndex] & cjwd_detail::tape_t::escapeBit) != 0;
+        const char* beginStr = tape_at(tapeIndex) + 1;
+        const char* endStr = tape_at(tapeIndex + 1);
+        if (!check_string(beginStr)) {
+            return false;
+        }
+        tapeIndex += 2;
+        begin = endStr;
+        // A mutable input may hold the string decoded by an earlier pass.
+        const char* escape = (isDecode & isEscaped)
+            ? static_cast<const char*>(std::memchr(beginStr, '\\', endStr - beginStr)) : nullptr;
+        if (escape == nullptr) {
+            result = std::string_view(beginStr, endStr - beginStr);
+            return true;
+        }
+        char* out = begin_unescaped(beginStr, escape);
+        char* const beginOut = out - (escape - beginStr);
+        while (escape != nullptr) {
+            const char* last = cjwd_detail::unescape(escape + 1, end, out);
+            if (last == nullptr) {
+                error = escape;
+                return false;
+            }
+            const char* run = last + 1;
+            escape = static_cast<const char*>(std::memchr(run, '\\', endStr - run));
+            const char* runEnd = escape != nullptr ? escape : endStr;
+            std::memmove(out, run, runEnd - run);
+            out += runEnd - run;
+        }
+        result = std::string_view(beginOut, out - beginOut);
+        return true;
+    }
+    // Reads the value of the current entry as the `value` step does.
+    template <typename handler_t, typename id_t>
+    bool read_tape_value(handler_t& handler, const bool isHandler, const id_t id, value_t& value) {
+        const char* at = tape_at(tapeIndex);
+        switch (*at) {
+        case '{': case '[': {
+            if (*at == '{') {
+                value.emplace<object_idx>();
+            }
+            else {
+                value.emplace<array_idx>();
+            }
+            ++tapeIndex;
+            begin = at + 1;
+            if (isHandler) {
+                handler(id, value);
+            }
+            if ((error != nullptr) | isStopped) {
+                return false;
+            }
+            if (begin == at + 1) {
+                if (isSkipChecked) {
+                    skip();
+                }
+                else {
+                    skip_tape_entries();
+                }
+                if (error != nullptr) {
+                    return false;
+                }
+            }
+            else {
+                sync_tape();
+            }
+            ++tapeIndex;
+            return true;
+        }
+        case '"': {
+            std::string_view string;
+            if (!read_tape_string(isHandler & policy_t::decodeEscapes, string)) {
+                return false;
+            }
+            const char* tokenEnd = begin + 1;
+            if (isHandler) {
+                value.emplace<string_idx>(string);
+                handler(id, value);
+                if (isStopped) {
+                    return false;
+                }
+            }
+            return check_token_end(tokenEnd);
+        }
+        case '-': case '+':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9': {
+            if (!policy_t::leadingPlus & (*at == '+')) {
+                begin = at;
+                error = at;
+                return false;
+            }
+            bool isFloatNumber = false;
+            const char* errorAt = nullptr;
+            const char* tokenEnd = lazyNumbers ? scan_raw_number(at, end, isFloatNumber, errorAt)
+                : cjwd_detail::scan_number(at, end, isFloatNumber);
+            ++tapeIndex;
+            if (tokenEnd == end) {
+                begin = end;
+                error = end;
+                return false;
+            }
+            if (!check_number(at, tokenEnd)) {
+                begin = at;
+                return false;
+            }
+            if (lazyNumbers) {
+                value.emplace<raw_number_idx>(std::string_view(at, tokenEnd - at), isFloatNumber);
+            }
+            else {
+                errorAt = parse_number(at, tokenEnd, isFloatNumber, value);
+            }
+            if (errorAt != nullptr) {
+                error = errorAt;
+                return false;
+            }
+            begin = tokenEnd - 1;
+            if (isHandler) {
+                handler(id, value);
+                if (isStopped) {
+                    return false;
+                }
+            }
+            return check_token_end(tokenEnd);
+        }
+        default:
+            if (end - at >= 5) {
+                size_t length = 0;
+                if (std::string_view(at, 4) == "null") {
+                    length = 4;
+                    value.emplace<null_idx>();
+                }
+                else if (std::string_view(at, 4) == "true") {
+                    length = 4;
+                    value.emplace<boolean_idx>(true);
+                }
+                else if (std::string_view(at, 5) == "false") {
+                    length = 5;
+                    value.emplace<boolean_idx>(false);
+                }
+                if (length != 0) {
+                    ++tapeIndex;
+                    begin = at + length - 1;
+                    if (isHandler) {
+                        handler(id, value);
+                        if (isStopped) {
+                            return false;
+                        }
+                    }
+                    return check_token_end(at + length);
+                }
+            }
+            begin = at;
+            error = at;
+            return false;
+        }
+    }
+    // The second stage of the structural index mode: the same steps as in
+    // parse_object, but driven by the entries.
+    template <typename handler_t>
+    void parse_object_tape(handler_t& handler) {
+        const bool isHandler = has_handler(handler, 0);
+        key_t key;
+        value_t value;
+        commas_t commas;
+        scratch_scope scope(get_scratch());
+        typename key_set_t::scope_t keys(keySet);
+        while (tapeIndex < tape.size) {
+            const char* at = tape_at(tapeIndex);
+            if (!policy_t::looseCommas && !check_commas(at, commas)) {
+                begin = at;
+                return;
+            }
+            switch (*at) {
+            case '}':
+                begin = at;
+                return;
+            case ',':
+                ++tapeIndex;
+                continue;
+            case '"':
+                break;
+            default:
+                begin = at;
+                error = at;
+                return;
+            }
+            scope.arena.release(scope.mark);
+            if (!read_tape_string((isHandler & policy_t::decodeEscapes) | isSkippedKeyDecoded, key)
+                    || !check_token_end(begin + 1)) {
+                return;
+            }
+            if (!keys.insert(key)) {
+                error = at;
+                return;
+            }
+            at = tapeIndex < tape.size ? tape_at(tapeIndex) : end;
+            if ((at == end) || (*at != ':')) {
+                error = at;
+                return;
+            }
+            ++tapeIndex;
+            if (tapeIndex == tape.size) {
+                break;
+            }
+            if (!read_tape_value(handler, isHandler, key, value)) {
+                return;
+            }
+        }
+        // The input ends before the closing bracket.
+        begin = end;
+        error = end;
+    }
+    template <typename handler_t>
+    void parse_array_tape(handler_t& handler) {
+        const bool isHandler = has_handler(handler, 0);
+        uint32_t index = 0;
+        value_t value;
+        commas_t commas;
+        scratch_scope scope(get_scratch());
+        while (tapeIndex < tape.size) {
+            const char* at = tape_at(tapeIndex);
+            if (!policy_t::looseCommas && !check_commas(at, commas)) {
+                begin = at;
+                return;
+            }
+            switch (*at) {
+            case ']':
+                begin = at;
+                return;
+            case ',':
+                ++tapeIndex;
+                continue;
+            case '"':
+                scope.arena.release(scope.mark);
+                break;
+            default:
+                break;
+            }
+            if (!read_tape_value(handler, isHandler, index, value)) {
+                return;
+            }
+            ++index;
+        }
+        // The input ends before the closing bracket.
+        begin = end;
+        error = end;
+    }
+
+    template <typename handler_t>
+    void parse_object(handler_t& handler) {
+        if ((error != nullptr) | isStopped) {
+            return;
+        }
+        root_scope root(*this);
+        if (is_tape() && enter_tape()) {
+            parse_object_tape(handler);
+            return;
+        }
+        const bool isHandler = has_handler(handler, 0);
+        enum class steps : uint8_t {
+            next,
+            key,
+            colon,
+            value,
+            string,
+            comment,
+        } step = steps::next;
+
+        const char* beginStr = nullptr;
+        bool isPrevEscape = false;
+        bool isStringWithEscape = false;
+        key_t key;
+        value_t value;
+        char* beginOut = nullptr;
+        char* out = nullptr;
+        commas_t commas;
+        scratch_scope scope(get_scratch());
+        typename key_set_t::scope_t keys(keySet);
+        for (; begin < end; ++begin) {
+            switch (step) {
+            case steps::next:
+                if (!policy_t::looseCommas && !check_commas(begin, commas)) {
+                    return;
+                }
+                switch (*begin) {
+                case '}':
+                    return;
+                case ',':
+                    if ((begin + 1 < end) && cjwd_detail::is_whitespace(begin[1])) {
+                        begin = cjwd_detail::skip_whitespace(begin + 2, end) - 1;
+                    }
+                    break;
+                case '"':
+                    if (!check_string(begin + 1)) {
+                        return;
+                    }
+                    step = steps::key;
+                    beginStr = begin + 1;
+                    isStringWithEscape = false;
+                    scope.arena.release(scope.mark);
+                    begin = cjwd_detail::find_quote_or_escape(beginStr, end) - 1;
+                    break;
+                case '/':
+                    if (!policy_t::comments) {
+                        error = begin;
+                        return;
+                    }
+                    step = steps::comment;
+                    beginStr = begin;
+                    break;
+                case ' ': case '\t': case '\r': case '\n':
+                    begin = cjwd_detail::skip_whitespace(begin + 1, end) - 1;
+                    break;
+                default:
+                    error = begin;
+                    return;
+                }
+                break;
+            case steps::key:
+                if (isPrevEscape) {
+                    isPrevEscape = false;
+                    break;
+                }
+                switch (*begin) {
+                case '"':
+                    step = steps::colon;
+                    if (isStringWithEscape) {
+                        key = std::string_view(beginOut, out - beginOut);
+                    }
+                    else {
+                        key = std::string_view(beginStr, begin - beginStr);
+                    }
+                    if (!keys.insert(key)) {
+                        error = beginStr - 1;
+                        return;
+                    }
+                    break;
+                case '\\': {
+                    if ((!isHandler | !policy_t::decodeEscapes) & !isSkippedKeyDecoded) {
+                        isPrevEscape = true;
+                        break;
+                    }
+                    if (!isStringWithEscape) {
+                        isStringWithEscape = true;
+                        out = begin_unescaped(beginStr, begin);
+                        beginOut = out - (begin - beginStr);
+                    }
+                    const char* last = cjwd_detail::unescape(begin + 1, end, out);
+                    if (last == nullptr) {
+                        error = begin;
+                        return;
+                    }
+                    begin = last;
+                    break;
+                }
+                default: {
+                    const char* next = cjwd_detail::find_quote_or_escape(begin + 1, end);
+                    if (isStringWithEscape) {
+                        std::memmove(out, begin, next - begin);
+                        out += next - begin;
+                    }
+                    begin = next - 1;
+                    break;
+                }
+                }
+                break;
+            case steps::colon:
+                switch (*begin) {
+                case ':':
+                    step = steps::value;
+                    if ((begin + 1 < end) && cjwd_detail::is_whitespace(begin[1])) {
+                        begin = cjwd_detail::skip_whitespace(begin + 2, end) - 1;
+                    }
+                    break;
+                case ' ': case '\t': case '\r': case '\n':
+                    begin = cjwd_detail::skip_whitespace(begin + 1, end) - 1;
+                    break;
+                default:
+                    error = begin;
+                    return;
+                }
+                break;
+            case steps::value:
+                switch (*begin) {
+                case '{': {
+                    value.emplace<object_idx>();
+                    auto beginBefore = ++begin;
+                    if (isHandler) {
+                        handler(key, value);
+                    }
+                    if (begin == beginBefore) {
+                        skip();
+                    }
+                    if ((error != nullptr) | isStopped) {
+                        return;
+                    }
+                    step = steps::next;
+                    break;
+                }
+                case '[': {
+                    value.emplace<array_idx>();
+                    auto beginBefore = ++begin;
+                    if (isHandler) {
+                        handler(key, value);
+                    }
+                    if (begin == beginBefore) {
+                        skip();
+                    }
+                    if ((error != nullptr) | isStopped) {
+                        return;
+                    }
+                    step = steps::next;
+                    break;
+                }
+                case '"':
+                    if (!check_string(begin + 1)) {
+                        return;
+                    }
+                    step = steps::string;
+                    beginStr = begin + 1;
+                    isStringWithEscape = false;
+                    begin = cjwd_detail::find_quote_or_escape(beginStr, end) - 1;
+                    break;
+                case '-': case '+':
+                case '0': case '1': case '2': case '3': case '4':
+                case '5': case '6': case '7': case '8': case '9': {
+                    if (!policy_t::leadingPlus & (*begin == '+')) {
+                        error = begin;
+                        return;
+                    }
+                    bool isFloatNumber = false;
+                    const char* errorAt = nullptr;
+                    const char* tokenEnd = lazyNumbers ? scan_raw_number(begin, end, isFloatNumber, errorAt)
+                        : cjwd_detail::scan_number(begin, end, isFloatNumber);
+                    if (tokenEnd == end) {
+                        // The input ends in the number, before the closing bracket.
+                        error = end;
+                        return;
+                    }
+                    if (!check_number(begin, tokenEnd)) {
+                        return;
+                    }
+                    if (lazyNumbers) {
+                        value.emplace<raw_number_idx>(
+                            std::string_view(begin, tokenEnd - begin), isFloatNumber);
+                    }
+                    else {
+                        errorAt = parse_number(begin, tokenEnd, isFloatNumber, value);
+                    }
+                    if (errorAt != nullptr) {
+                        error = errorAt;
+                        return;
+                    }
+                    begin = tokenEnd - 1;
+                    if (isHandler) {
+                        handler(key, value);
+                        if (isStopped) {
+                            return;
+                        }
+                    }
+                    if (!check_scalar_end(begin + 1)) {
+                        return;
+                    }
+                    step = steps::next;
+                    break;
+                }
+                case ' ': case '\t': case '\r': case '\n':
+                    begin = cjwd_detail::skip_whitespace(begin + 1, end) - 1;
+                    break;
+                default:
+                    if (end - begin >= 5) {
+                        if (std::string_view(begin, 4) == "null") {
+                            begin += 4 - 1;
+                            if (isHandler) {
+                                value.emplace<null_idx>();
+                                handler(key, value);
+                                if (isStopped) {
+                                    return;
+                                }
+                            }
+                            if (!check_scalar_end(begin + 1)) {
+                                return;
+                            }
+                            step = steps::next;
+                            break;
+                        }
+                        else if (std::string_view(begin, 4) == "true") {
+                            begin += 4 - 1;
+                            if (isHandler) {
+                                value.emplace<boolean_idx>(true);
+                                handler(key, value);
+                                if (isStopped) {
+                                    return;
+                                }
+                            }
+                            if (!check_scalar_end(begin + 1)) {
+                                return;
+                            }
+                            step = steps::next;
+                            break;
+                        }
+                        else if (std::string_view(begin, 5) == "false") {
+                            begin += 5 - 1;
+                            if (isHandler) {
+                                value.emplace<boolean_idx>(false);
+                                handler(key, value);
+                                if (isStopped) {
+                                    return;
+                                }
+                            }
+                            if (!check_scalar_end(begin + 1)) {
+                                return;
+                            }
+                            step = steps::next;
+                            break;
+                        }
+                    }
+                    error = begin;
+                    return;
+                }
+                break;
+            case steps::string:
+                if (isPrevEscape) {
+                    isPrevEscape = false;
+                    break;
+                }
+                switch (*begin) {
+                case '"':
+                    if (isHandler) {
+                        if (isStringWithEscape) {
+                            value.emplace<string_idx>(std::string_view(beginOut, out - beginOut));
+                        }
+                        else {
+                            value.emplace<string_idx>(std::string_view(beginStr, begin - beginStr));
+                        }
+                        handler(key, value);
+                        if (isStopped) {
+                            return;
+                        }
+                    }
+                    step = steps::next;
+                    break;
+                case '\\': {
+                    if (!isHandler | !policy_t::decodeEscapes) {
+                        isPrevEscape = true;
+                        break;
+                    }
+                    if (!isStringWithEscape) {
+                        isStringWithEscape = true;
+                        out = begin_unescaped(beginStr, begin);
+                        beginOut = out - (begin - beginStr);
+                    }
+                    const char* last = cjwd_detail::unescape(begin + 1, end, out);
+                    if (last == nullptr) {
+                        error = begin;
+                        return;
+                    }
+                    begin = last;
+                    break;
+                }
+                default: {
+                    const char* next = cjwd_detail::find_quote_or_escape(begin + 1, end);
+                    if (isHandler & isStringWithEscape) {
+                        std::memmove(out, begin, next - begin);
+                        out += next - begin;
+                    }
+                    begin = next - 1;
+                    break;
+                }
+                }
+                break;
+            case steps::comment:
+                switch (*begin) {
+                case '\r': case '\n':
+                    step = steps::next;
+                    break;
+                default:
+                    break;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        // The input ends before the closing bracket.
+        error = end;
+    }
 
-    void operator=(const std::string_view json) {
+    template <typename handler_t>
+    void parse_array(handler_t& handler) {
+        if ((error != nullptr) | isStopped) {
+            return;
+        }
+        root_scope root(*this);
+        if (is_tape() && enter_tape()) {
+            parse_array_tape(handler);
+            return;
+        }
+        const bool isHandler = has_handler(handler, 0);
+        enum class steps : uint8_t {
+            next,
+            string,
+            comment,
+        } step = steps::next;
+
+        const char* beginStr = nullptr;
+        bool isPrevEscape = false;
+        bool isStringWithEscape = false;
+        uint32_t index = 0;
+        value_t value;
+        char* beginOut = nullptr;
+        char* out = nullptr;
+        commas_t commas;
+        scratch_scope scope(get_scratch());
+        for (; begin < end; ++begin) {
+            switch (step) {
+            case steps::next:
+                if (!policy_t::looseCommas && !check_commas(begin, commas)) {
+                    return;
+                }
+                switch (*begin) {
+                case ']':
+                    return;
+                case ',':
+                    if ((begin + 1 < end) && cjwd_detail::is_whitespace(begin[1])) {
+                        begin = cjwd_detail::skip_whitespace(begin + 2, end) - 1;
+                    }
+                    break;
+                case '{': {
+                    value.emplace<object_idx>();
+                    auto beginBefore = ++begin;
+                    if (isHandler) {
+                        handler(index, value);
+                    }
+                    if (begin == beginBefore) {
+                        skip();
+                    }
+                    if ((error != nullptr) | isStopped) {
+                        return;
+                    }
+                    step = steps::next;
+                    ++index;
+                    break;
+                }
+                case '[': {
+                    value.emplace<array_idx>();
+                    auto beginBefore = ++begin;
+                    if (isHandler) {
+                        handler(index, value);
+                    }
+                    if (begin == beginBefore) {
+                        skip();
+                    }
+                    if ((error != nullptr) | isStopped) {
+                        return;
+                    }
+                    step = steps::next;
+                    ++index;
+                    break;
+                }
+                case '-': case '+':
+                case '0': case '1': case '2': case '3': case '4':
+                case '5': case '6': case '7': case '8': case '9': {
+                    if (!policy_t::leadingPlus & (*begin == '+')) {
+                        error = begin;
+                        return;
+                    }
+                    bool isFloatNumber = false;
+                    const char* errorAt = nullptr;
+                    const char* tokenEnd = lazyNumbers ? scan_raw_number(begin, end, isFloatNumber, errorAt)
+                        : cjwd_detail::scan_number(begin, end, isFloatNumber);
+                    if (tokenEnd == end) {
+                        // The input ends in the number, before the closing bracket.
+                        error = end;
+                        return;
+                    }
+                    if (!check_number(begin, tokenEnd)) {
+                        return;
+                    }
+                    if (lazyNumbers) {
+                        value.emplace<raw_number_idx>(
+                            std::string_view(begin, tokenEnd - begin), isFloatNumber);
+                    }
+                    else {
+                        errorAt = parse_number(begin, tokenEnd, isFloatNumber, value);
+                    }
+                    if (errorAt != nullptr) {
+                        error = errorAt;
+                        return;
+                    }
+                    begin = tokenEnd - 1;
+                    if (isHandler) {
+                        handler(index, value);
+                        if (isStopped) {
+                            return;
+                        }
+                    }
+                    if (!check_scalar_end(begin + 1)) {
+                        return;
+                    }
+                    step = steps::next;
+                    ++index;
+                    break;
+                }
+                case '"':
+                    if (!check_string(begin + 1)) {
+                        return;
+                    }
+                    step = steps::string;
+                    beginStr = begin + 1;
+                    isStringWithEscape = false;
+                    scope.arena.release(scope.mark);
+                    begin = cjwd_detail::find_quote_or_escape(beginStr, end) - 1;
+                    break;
+                case '/':
+                    if (!policy_t::comments) {
+                        error = begin;
+                        return;
+                    }
+                    step = steps::comment;
+                    beginStr = begin;
+                    break;
+                case ' ': case '\t': case '\r': case '\n':
+                    begin = cjwd_detail::skip_whitespace(begin + 1, end) - 1;
+                    break;
+                default:
+                    if (end - begin >= 5) {
+                        if (std::string_view(begin, 4) == "null") {
+                            begin += 4 - 1;
+                            if (isHandler) {
+                                value.emplace<null_idx>();
+                                handler(index, value);
+                                if (isStopped) {
+                                    return;
+                                }
+                            }
+                            if (!check_scalar_end(begin + 1)) {
+                                return;
+                            }
+                            step = steps::next;
+                            ++index;
+                            break;
+                        }
+                        else if (std::string_view(begin, 4) == "true") {
+                            begin += 4 - 1;
+                            if (isHandler) {
+                                value.emplace<boolean_idx>(true);
+                                handler(index, value);
+                                if (isStopped) {
+                                    return;
+                                }
+                            }
+                            if (!check_scalar_end(begin + 1)) {
+                                return;
+                            }
+                            step = steps::next;
+                            ++index;
+                            break;
+                        }
+                        else if (std::string_view(begin, 5) == "false") {
+                            begin += 5 - 1;
+                            if (isHandler) {
+                                value.emplace<boolean_idx>(false);
+                                handler(index, value);
+                                if (isStopped) {
+                                    return;
+                                }
+                            }
+                            if (!check_scalar_end(begin + 1)) {
+                                return;
+                            }
+                            step = steps::next;
+                            ++index;
+                            break;
+                        }
+                    }
+                    error = begin;
+                    return;
+                }
+                break;
+            case steps::string:
+                if (isPrevEscape) {
+                    isPrevEscape = false;
+                    break;
+                }
+                switch (*begin) {
+                case '"':
+                    if (isHandler) {
+                        if (isStringWithEscape) {
+                            value.emplace<string_idx>(std::string_view(beginOut, out - beginOut));
+                        }
+                        else {
+                            value.emplace<string_idx>(std::string_view(beginStr, begin - beginStr));
+                        }
+                        handler(index, value);
+                        if (isStopped) {
+                            return;
+                        }
+                    }
+                    step = steps::next;
+                    ++index;
+                    break;
+                case '\\': {
+                    if (!isHandler | !policy_t::decodeEscapes) {
+                        isPrevEscape = true;
+                        break;
+                    }
+                    if (!isStringWithEscape) {
+                        isStringWithEscape = true;
+                        out = begin_unescaped(beginStr, begin);
+                        beginOut = out - (begin - beginStr);
+                    }
+                    const char* last = cjwd_detail::unescape(begin + 1, end, out);
+                    if (last == nullptr) {
+                        error = begin;
+                        return;
+                    }
+                    begin = last;
+                    break;
+                }
+                default: {
+                    const char* next = cjwd_detail::find_quote_or_escape(begin + 1, end);
+                    if (isHandler & isStringWithEscape) {
+                        std::memmove(out, begin, next - begin);
+                        out += next - begin;
+                    }
+                    begin = next - 1;
+                    break;
+                }
+                }
+                break;
+            case steps::comment:
+                switch (*begin) {
+                case '\r': case '\n':
+                    step = steps::next;
+                    break;
+                default:
+                    break;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        // The input ends before the closing bracket.
+        error = end;
+    }
+};
+using json_reader = basic_json_reader<>;
+using json_strict_reader = basic_json_reader<json_strict_policy>;
+
+// Pull parser over the same zero-copy input as json_reader, the caller
+// drives the loops instead of handlers:
+//     json_cursor cursor;
+//     cursor = input;
+//     cursor.next_value(value); // the root
+//     cursor.enter();
+//     while (cursor.next_key(key) && cursor.next_value(value)) { ... }
+// The state is fixed, up to `maxDepth` levels, so a cursor can be copied to
+// continue elsewhere. The steps are inlined into the loops of the caller.
+// Escaped strings are decoded into the scratch arena,
+// they stay valid until the next key, or the next element of an array.
+// A copy does not take over the decoded strings, it decodes into its own
+// arena, or the shared `scratch`.
+struct json_cursor {
+    using key_t = json_reader::key_t;
+    using value_t = json_reader::value_t;
+    using scratch_t = json_reader::scratch_t;
+    static constexpr uint32_t maxDepth = 64;
+
+    const char* begin = nullptr; // the read position
+    const char* end = nullptr;
+    const char* error = nullptr; // nullptr if no errors
+    bool lazyNumbers = false; // see json_reader::lazyNumbers
+    scratch_t* scratch = nullptr; // unescaped strings, internal if nullptr
+
+    json_cursor& operator=(const std::string_view json) {
         begin = json.data();
         end = json.data() + json.size();
         error = nullptr;
-        rootType = 0;
-        while (begin < end) {
-            switch (*begin++) {
-            case '{':
-                rootType = 1;
-                return;
-            case '[':
-                rootType = 2;
+        objects = 0;
+        level = 0;
+        state = states::root;
+        return *this;
+    }
+
+    // Reads the next key of the current object and its `:`. Returns false at
+    // the end of the object, which is left then, or on error. An unread value
+    // of the previous key is skipped.
+    CJWD_FORCE_INLINE bool next_key(key_t& key) {
+        if (((state != states::key) | (error != nullptr) | decoded.isUsed) && !resume_key()) {
+            return false;
+        }
+        const char* at = skip_separators(begin, true);
+        if ((at == end) || (*at != '"')) {
+            return close(at, '}');
+        }
+        begin = at;
+        if (!read_string(key)) {
+            return false;
+        }
+        at = begin;
+        if ((at == end) || (*at != ':')) { // mostly right after the key
+            at = skip_separators(at, false);
+            if ((at == end) || (*at != ':')) {
+                error = at;
+                return false;
+            }
+        }
+        begin = at + 1;
+        state = states::value;
+        return true;
+    }
+    // Reads the root value, the value of the last key, or the next element of
+    // the current array. An object or array is not entered, see enter() and
+    // skip(). Returns false at the end of the array, which is left then, after
+    // the root value, or on error.
+    CJWD_FORCE_INLINE bool next_value(value_t& value) {
+        if ((((state != states::value) & (state != states::element)) | (error != nullptr) | decoded.isUsed)
+                && !resume_value()) {
+            return false;
+        }
+        const char* at = nullptr;
+        if (state == states::element) {
+            at = skip_separators(begin, true);
+            if ((at == end) || (*at == ']')) {
+                return close(at, ']');
+            }
+        }
+        else {
+            at = skip_separators(begin, false);
+            if (at == end) {
+                error = end;
+                return false;
+            }
+        }
+        begin = at;
+        if (!read_value(value)) {
+            error = error != nullptr ? error : at;
+            return false;
+        }
+        return true;
+    }
+    // Enters the object or array just returned by next_value().
+    CJWD_FORCE_INLINE bool enter() {
+        if ((state != states::pending) | (error != nullptr)) {
+            return false;
+        }
+        if (level == maxDepth) {
+            error = begin - 1;
+            return false;
+        }
+        const bool isObject = begin[-1] == '{';
+        objects = (objects & ~(1ull << level)) | (static_cast<uint64_t>(isObject) << level);
+        ++level;
+        state = isObject ? states::key : states::element;
+        return true;
+    }
+    // Skips the object or array just returned by next_value(), or the value
+    // of the last key, otherwise the rest of the current object or array,
+    // which is left then.
+    void skip() {
+        if (error != nullptr) {
+            return;
+        }
+        if ((state == states::value) | (state == states::root)) {
+            value_t value;
+            if (!next_value(value) || (state != states::pending)) {
                 return;
-            default:
-                break;
             }
         }
-        error = begin;
+        if (state == states::done) {
+            return;
+        }
+        cjwd_detail::skip_state skipState;
+        begin = cjwd_detail::skip_container(begin, end, skipState);
+        if (begin == end) {
+            error = end;
+            return;
+        }
+        ++begin;
+        if (state != states::pending) {
+            --level;
+        }
+        state = after_value();
+    }
+    // The number of entered objects and arrays.
+    uint32_t depth() const {
+        return level;
+    }
+    bool is_object() const {
+        return (level != 0) && (((objects >> (level - 1)) & 1) != 0);
+    }
+    bool is_array() const {
+        return (level != 0) && (((objects >> (level - 1)) & 1) == 0);
     }
 
-    struct object_t {};
-    struct array_t {};
-    struct null_t {};
-    using key_t = std::string_view;
-    enum idx : uint8_t {
-        number_idx, // use strings for big integers
-        string_idx,
-        boolean_idx,
-        array_idx,
-        object_idx,
-        null_idx,
+private:
+    enum class states : uint8_t {
+        root, // before the root value
+        key, // before a key
+        value, // after a key
+        element, // before an element of an array
+        pending, // after an object or array that is not entered
+        done, // after the root value
     };
-    struct value_t : public std::variant<
-            double, std::string_view, bool, array_t, object_t, null_t> {
-        bool is_number() const {
-            return index() == number_idx;
+
+    uint64_t objects = 0; // a bit per level, 1 for an object
+    uint32_t level = 0;
+    states state = states::root;
+    // The strings decoded into the arena since `mark`. A copy of the cursor
+    // starts without them and with an empty own arena, the strings of the
+    // original are not copied.
+    struct decoded_t {
+        scratch_t ownScratch;
+        scratch_t::mark_t mark = { 0, 0 };
+        bool isUsed = false;
+
+        decoded_t() = default;
+        decoded_t(const decoded_t&) {}
+        decoded_t& operator=(const decoded_t&) {
+            ownScratch.clear();
+            isUsed = false;
+            return *this;
         }
-        double as_number() const {
-            return std::get<number_idx>(*this);
+    } decoded;
+
+    // The slow paths of next_key() and next_value(), out of the loops of the
+    // caller: skip an unread value, return false if the step is not possible.
+    CJWD_NOINLINE bool resume_key() {
+        if ((state == states::pending) | (state == states::value)) {
+            skip();
         }
-        bool is_string() const {
-            return index() == string_idx;
+        if ((state != states::key) | (error != nullptr)) {
+            error = error != nullptr ? error : begin;
+            return false;
         }
-        const std::string_view as_string() const {
-            return std::get<string_idx>(*this);
+        release_scratch();
+        return true;
+    }
+    CJWD_NOINLINE bool resume_value() {
+        if (state == states::pending) {
+            skip();
         }
-        bool is_boolean() const {
-            return index() == boolean_idx;
+        if ((state == states::key) | (error != nullptr)) {
+            error = error != nullptr ? error : begin;
+            return false;
         }
-        bool as_boolean() const {
-            return std::get<boolean_idx>(*this);
+        if (state == states::element) {
+            release_scratch();
         }
-        bool is_array() const {
-            return index() == array_idx;
+        return state != states::done;
+    }
+    states after_value() const {
+        return level == 0 ? states::done : is_object() ? states::key : states::element;
+    }
+    // The state after a value just read in the state `state`.
+    states after_read() const {
+        return state == states::value ? states::key : state == states::element ? states::element : states::done;
+    }
+    scratch_t& get_scratch() {
+        return scratch != nullptr ? *scratch : decoded.ownScratch;
+    }
+    // Frees the decoded strings of the cursor, not the earlier strings of
+    // a shared arena.
+    void release_scratch() {
+        if (decoded.isUsed) {
+            decoded.isUsed = false;
+            get_scratch().release(decoded.mark);
         }
-        bool is_object() const {
-            return index() == object_idx;
+    }
+    // Leaves the current container at its closing bracket `at`.
+    CJWD_FORCE_INLINE bool close(const char* at, const char bracket) {
+        if ((at == end) || (*at != bracket)) {
+            error = at;
+            return false;
         }
-        bool is_null() const {
-            return index() == null_idx;
+        begin = at + 1;
+        --level;
+        state = after_value();
+        return false;
+    }
+    // Skips whitespace, comments, and commas between values if `isCommas`.
+    CJWD_FORCE_INLINE const char* skip_separators(const char* at, const bool isCommas) {
+        // The bytes that start a separator, all below 64.
+        const uint64_t separators = (1ull << ' ') | (1ull << '\t') | (1ull << '\n') | (1ull << '\r') |
+            (1ull << '/') | (static_cast<uint64_t>(isCommas) << ',');
+        for (;;) {
+            if (at == end) {
+                return at;
+            }
+            const uint8_t byte = static_cast<uint8_t>(*at);
+            if ((byte >= 64) || (((separators >> byte) & 1) == 0)) { // mostly
+                return at;
+            }
+            if (byte == ',') {
+                ++at;
+            }
+            else if (byte == '/') {
+                if ((end - at < 2) || (at[1] != '/')) {
+                    return at;
+                }
+                const void* newline = std::memchr(at, '\n', end - at);
+                at = newline != nullptr ? static_cast<const char*>(newline) : end;
+            }
+            else if ((at + 1 < end) && cjwd_detail::is_whitespace(at[1])) {
+                at = cjwd_detail::skip_whitespace(at + 2, end);
+            }
+            else { // mostly one space
+                ++at;
+            }
+        }
+    }
+    // Reads the string at `begin` and moves after it.
+    CJWD_FORCE_INLINE bool read_string(std::string_view& result) {
+        const char* beginStr = begin + 1;
+        const char* escape = cjwd_detail::find_quote_or_escape_inline(beginStr, end);
+        if (escape == end) {
+            error = end;
+            return false;
+        }
+        if (*escape == '"') {
+            result = std::string_view(beginStr, escape - beginStr);
+            begin = escape + 1;
+            return true;
+        }
+        return read_escaped_string(beginStr, escape, result);
+    }
+    // Decodes the string [beginStr, closing `"`) with the first escape at
+    // `escape` into the arena and moves after it.
+    CJWD_NOINLINE bool read_escaped_string(const char* beginStr, const char* escape, std::string_view& result) {
+        const char* endStr = cjwd_detail::find_string_end(escape, end);
+        if (endStr == end) {
+            error = end;
+            return false;
+        }
+        scratch_t& arena = get_scratch();
+        if (!decoded.isUsed) {
+            decoded.isUsed = true;
+            decoded.mark = arena.mark();
+        }
+        char* const beginOut = arena.allocate(endStr - beginStr);
+        std::memcpy(beginOut, beginStr, escape - beginStr);
+        char* out = beginOut + (escape - beginStr);
+        while (escape != nullptr) {
+            const char* last = cjwd_detail::unescape(escape + 1, endStr, out);
+            if (last == nullptr) {
+                error = escape;
+                return false;
+            }
+            const char* run = last + 1;
+            escape = static_cast<const char*>(std::memchr(run, '\\', endStr - run));
+            const char* runEnd = escape != nullptr ? escape : endStr;
+            std::memmove(out, run, runEnd - run);
+            out += runEnd - run;
+        }
+        result = std::string_view(beginOut, out - beginOut);
+        begin = endStr + 1;
+        return true;
+    }
+    // Reads the value at `begin` and moves after it, or into it for an object
+    // or array.
+    CJWD_FORCE_INLINE bool read_value(value_t& value) {
+        if (*begin == '"') { // mostly strings
+            std::string_view string;
+            if (!read_string(string)) {
+                return false;
+            }
+            value.emplace<json_reader::string_idx>(string.data(), string.size());
+            state = after_read();
+            return true;
+        }
+        if ((*begin == '{') | (*begin == '[')) {
+            if (*begin == '{') {
+                value.emplace<json_reader::object_idx>();
+            }
+            else {
+                value.emplace<json_reader::array_idx>();
+            }
+            ++begin;
+            state = states::pending;
+            return true;
+        }
+        return read_scalar(value);
+    }
+    // Reads a number, `null`, `true` or `false` at `begin`.
+    CJWD_NOINLINE bool read_scalar(value_t& value) {
+        switch (*begin) {
+        case '-': case '+':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9': {
+            bool isFloatNumber = false;
+            const char* errorAt = nullptr;
+            const char* tokenEnd = lazyNumbers
+                ? json_reader::scan_raw_number(begin, end, isFloatNumber, errorAt)
+                : cjwd_detail::scan_number(begin, end, isFloatNumber);
+            if (lazyNumbers) {
+                value.emplace<json_reader::raw_number_idx>(
+                    std::string_view(begin, tokenEnd - begin), isFloatNumber);
+            }
+            else {
+                errorAt = json_reader::parse_number(begin, tokenEnd, isFloatNumber, value);
+            }
+            if (errorAt != nullptr) {
+                error = errorAt;
+                return false;
+            }
+            begin = tokenEnd;
+            break;
+        }
+        default: {
+            const std::string_view rest(begin, end - begin);
+            if (rest.substr(0, 4) == "null") {
+                value.emplace<json_reader::null_idx>();
+                begin += 4;
+            }
+            else if (rest.substr(0, 4) == "true") {
+                value.emplace<json_reader::boolean_idx>(true);
+                begin += 4;
+            }
+            else if (rest.substr(0, 5) == "false") {
+                value.emplace<json_reader::boolean_idx>(false);
+                begin += 5;
+            }
+            else {
+                return false;
+            }
+            break;
+        }
+        }
+        state = after_read();
+        return true;
+    }
+};
+
+#if defined(CJWD_COROUTINES)
+namespace cjwd_detail {
+// Coroutine frames of a thread that are kept for reuse, a frame is freed
+// to the thread that destroys it.
+struct frame_pool {
+    static constexpr uint32_t maxFrames = 16;
+
+    static void* allocate(const size_t size) {
+        list_t& list = free_list();
+        for (node_t** it = &list.head; *it != nullptr; it = &(*it)->next) {
+            if ((*it)->size == size) {
+                node_t* node = *it;
+                *it = node->next;
+                --list.count;
+                return node;
+            }
         }
+        return ::operator new(size < sizeof(node_t) ? sizeof(node_t) : size);
+    }
+    static void release(void* frame, const size_t size) {
+        list_t& list = free_list();
+        if (list.count == maxFrames) {
+            ::operator delete(frame);
+            return;
+        }
+        list.head = new (frame) node_t{ list.head, size };
+        ++list.count;
+    }
+
+private:
+    struct node_t {
+        node_t* next;
+        size_t size;
     };
+    struct list_t {
+        node_t* head = nullptr;
+        uint32_t count = 0;
 
-    bool is_object() const {
-        return rootType == 1;
+        ~list_t() {
+            while (head != nullptr) {
+                node_t* next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    };
+    static list_t& free_list() {
+        thread_local list_t list;
+        return list;
     }
-    bool is_array() const {
-        return rootType == 2;
+};
+} // namespace cjwd_detail
+
+// An event of json_events().
+struct json_event {
+    enum class types : uint8_t {
+        begin_object,
+        end_object,
+        begin_array,
+        end_array,
+        key,
+        value, // a string, number, boolean or null
+    };
+    types type = types::value;
+    json_reader::key_t key; // also set for the value of the key, empty in arrays
+    json_reader::value_t value; // also object or array for begin_*
+};
+
+// A lazy sequence of json_event. Events are produced on demand, so the
+// consumer may suspend between them. An event and its strings are valid
+// until the next one.
+struct json_event_generator {
+    struct promise_type {
+        const json_event* event = nullptr;
+        const char* error = nullptr;
+
+        json_event_generator get_return_object() {
+            return json_event_generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+        std::suspend_always yield_value(const json_event& event_) noexcept {
+            event = &event_;
+            return {};
+        }
+        // Waits for the next chunk of json_event_input.
+        std::suspend_always yield_value(std::nullptr_t) noexcept {
+            event = nullptr;
+            return {};
+        }
+        void return_value(const char* error_) noexcept {
+            error = error_;
+        }
+        void unhandled_exception() {
+            std::terminate();
+        }
+        // Frames are reused, there are no allocations per document once warm.
+        static void* operator new(const size_t size) {
+            return cjwd_detail::frame_pool::allocate(size);
+        }
+        static void operator delete(void* frame, const size_t size) {
+            cjwd_detail::frame_pool::release(frame, size);
+        }
+    };
+    struct sentinel_t {};
+    struct iterator {
+        std::coroutine_handle<promise_type> handle;
+
+        const json_event& operator*() const {
+            return *handle.promise().event;
+        }
+        const json_event* operator->() const {
+            return handle.promise().event;
+        }
+        iterator& operator++() {
+            handle.resume();
+            return *this;
+        }
+        bool operator==(sentinel_t) const {
+            return handle.done() || (handle.promise().event == nullptr);
+        }
+    };
+
+    json_event_generator(json_event_generator&& other) noexcept : handle(other.handle) {
+        other.handle = nullptr;
+    }
+    json_event_generator& operator=(json_event_generator&& other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    ~json_event_generator() {
+        if (handle) {
+            handle.destroy();
+        }
     }
 
-    void parse(std::function<void(key_t key, const value_t& value)> handler) {
-        if (error != nullptr) {
-            return;
+    // Produces the next event, returns false after the last one, or while
+    // the generator waits for json_event_input.
+    bool next() {
+        if (!handle.done()) {
+            handle.resume();
         }
-        enum class steps : uint8_t {
-            next,
-            key,
-            colon,
-            value,
-            number,
-            string,
-            comment,
-        } step = steps::next;
+        return !handle.done() && (handle.promise().event != nullptr);
+    }
+    const json_event& event() const {
+        return *handle.promise().event;
+    }
+    // nullptr if no errors, check after the last event.
+    const char* error() const {
+        return handle.done() ? handle.promise().error : nullptr;
+    }
+    iterator begin() {
+        next();
+        return iterator{ handle };
+    }
+    sentinel_t end() const {
+        return {};
+    }
 
-        const char* beginStr = nullptr;
-        bool isPrevEscape = false;
-        bool isStringWithEscape = false;
-        key_t key;
-        std::string keyStr;
-        value_t value;
-        std::string valueStr;
-        for (; begin < end; ++begin) {
-            switch (step) {
-            case steps::next:
-                switch (*begin) {
-                case '}':
-                    return;
-                case ',':
-                    break;
-                case '"':
-                    step = steps::key;
-                    beginStr = begin + 1;
-                    break;
-                case '/':
-                    step = steps::comment;
-                    beginStr = begin;
-                    break;
-                case ' ': case '\t': case '\r': case '\n':
-                    break;
-                default:
-                    error = begin;
-                    return;
-                }
+private:
+    explicit json_event_generator(std::coroutine_handle<promise_type> handle_) : handle(handle_) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace cjwd_detail {
+// The steps of json_events() between its events.
+struct event_reader {
+    json_cursor cursor;
+    json_event event;
+    enum class steps : uint8_t {
+        root, // before the root value
+        enter, // after begin_object or begin_array
+        value, // after a key
+        next, // after a value or an end_*
+    } step = steps::root;
+
+    // Reads the next event, returns false after the last one or on error.
+    bool next() {
+        switch (step) {
+        case steps::root:
+        case steps::value:
+            return cursor.next_value(event.value) && report_value();
+        case steps::enter:
+            cursor.enter();
+            break;
+        case steps::next:
+            break;
+        }
+        if (cursor.depth() == 0) {
+            return false;
+        }
+        if (cursor.is_object()) {
+            if (cursor.next_key(event.key)) {
+                event.type = json_event::types::key;
+                step = steps::value;
+                return true;
+            }
+            event.type = json_event::types::end_object;
+        }
+        else {
+            event.key = json_reader::key_t();
+            if (cursor.next_value(event.value)) {
+                return report_value();
+            }
+            event.type = json_event::types::end_array;
+        }
+        if (cursor.error != nullptr) {
+            return false;
+        }
+        event.key = json_reader::key_t();
+        step = steps::next;
+        return true;
+    }
+
+private:
+    bool report_value() {
+        if (event.value.is_object() | event.value.is_array()) {
+            event.type = event.value.is_object() ? json_event::types::begin_object : json_event::types::begin_array;
+            step = steps::enter;
+        }
+        else {
+            event.type = json_event::types::value;
+            step = steps::next;
+        }
+        return true;
+    }
+};
+} // namespace cjwd_detail
+
+// Generates the events of a document, driven by json_cursor:
+//     for (const json_event& event : json_events(input)) { ... }
+// `input` must outlive the generator.
+inline json_event_generator json_events(const std::string_view input, const bool lazyNumbers = false) {
+    cjwd_detail::event_reader reader;
+    reader.cursor.lazyNumbers = lazyNumbers;
+    reader.cursor = input;
+    while (reader.next()) {
+        co_yield reader.event;
+    }
+    co_return reader.cursor.error;
+}
+
+// Chunks of a document for json_events(input), for example from a socket:
+//     json_event_input input;
+//     json_event_generator events = json_events(input);
+//     input.push(chunk); // for each chunk
+//     for (const json_event& event : events) { ... } // until more input is needed
+//     input.finish(); // then the last events
+// The generator is resumed by the loops after push() and finish().
+struct json_event_input {
+    // The position of `error()` of the generator in the whole document.
+    uint64_t errorOffset = 0;
+
+    // Queues the next chunk, which may be freed after the call.
+    void push(const std::string_view chunk) {
+        pushed.append(chunk.data(), chunk.size());
+    }
+    // Call after the last chunk.
+    void finish() {
+        isFinished = true;
+    }
+
+private:
+    friend json_event_generator json_events(json_event_input& input, bool lazyNumbers);
+
+    std::string buffer; // from the first byte that is not read yet
+    std::string pushed; // moved to `buffer` while the generator waits
+    uint64_t erasedSize = 0; // before `buffer`
+    bool isFinished = false;
+};
+
+// Generates the events of a document pushed to `input` in chunks. A step
+// that reaches the end of the pushed bytes, inside a token or before the
+// next one, is read again with the next chunk, the bytes before it are
+// released. The generator waits instead of producing an event then, next()
+// returns false without `error()`. A token split between chunks is read
+// again from its start.
+inline json_event_generator json_events(json_event_input& input, const bool lazyNumbers = false) {
+    cjwd_detail::event_reader reader;
+    reader.cursor.lazyNumbers = lazyNumbers;
+    reader.cursor = std::string_view(input.buffer);
+    json_cursor saved;
+    std::string savedKey;
+    for (;;) {
+        saved = reader.cursor;
+        const cjwd_detail::event_reader::steps savedStep = reader.step;
+        const json_reader::key_t key = reader.event.key;
+        const bool isEvent = reader.next();
+        const json_cursor& cursor = reader.cursor;
+        // A literal is reported at its start, a number or literal may go on
+        // in the next chunk.
+        const bool isIncomplete = (cursor.error != nullptr) ? (cursor.end - cursor.error < 5)
+            : (cursor.begin == cursor.end) && (cursor.end != input.buffer.data())
+                && (std::memchr("\"{}[]:", cursor.end[-1], 6) == nullptr);
+        if (!isIncomplete || (input.isFinished && input.pushed.empty())) {
+            if (!isEvent) {
                 break;
-            case steps::key:
-                if (isPrevEscape) {
-                    isPrevEscape = false;
-                    if (handler) {
-                        keyStr.push_back(*begin);
-                    }
-                    break;
-                }
+            }
+            co_yield reader.event;
+            continue;
+        }
+        // The key of the next value may be in the released bytes or strings.
+        if (key.data() != savedKey.data()) {
+            savedKey.assign(key.data(), key.size());
+        }
+        reader.event.key = savedKey;
+        reader.cursor = saved;
+        reader.step = savedStep;
+        // The byte before the read position is kept, enter() looks at the bracket.
+        const size_t position = reader.cursor.begin - input.buffer.data();
+        const size_t readSize = position > 0 ? position - 1 : 0;
+        input.buffer.erase(0, readSize);
+        input.erasedSize += readSize;
+        while (input.pushed.empty() & !input.isFinished) {
+            co_yield nullptr;
+        }
+        if (input.buffer.empty()) {
+            input.buffer.swap(input.pushed);
+        }
+        else {
+            input.buffer += input.pushed;
+        }
+        input.pushed.clear();
+        reader.cursor.begin = input.buffer.data() + (position - readSize);
+        reader.cursor.end = input.buffer.data() + input.buffer.size();
+    }
+    if (reader.cursor.error != nullptr) {
+        input.errorOffset = input.erasedSize + (reader.cursor.error - input.buffer.data());
+    }
+    co_return reader.cursor.error;
+}
+#endif // CJWD_COROUTINES
+
+// Parses a document that arrives in chunks, for example from a socket.
+// Handlers are registered by parse() as in json_reader: before the first
+// chunk for the root, and inside a handler for a nested object or array,
+// otherwise the nested value is skipped. Keys, strings and numbers split
+// between chunks are buffered, everything else is zero-copy.
+struct json_push_reader {
+    using key_t = json_reader::key_t;
+    using value_t = json_reader::value_t;
+    using object_handler_t = std::function<void(key_t key, const value_t& value)>;
+    using array_handler_t = std::function<void(uint32_t index, const value_t& value)>;
+
+    // Check after push and finish. It points into the chunk of the push that
+    // found the error, and is valid only while that chunk is, `errorOffset`
+    // is the position of the error in the whole document.
+    const char* error = nullptr;
+    uint64_t errorOffset = 0;
+
+    void parse(object_handler_t handler) {
+        open(true, std::move(handler), nullptr);
+    }
+    void parse(array_handler_t handler) {
+        open(false, nullptr, std::move(handler));
+    }
+    // Parses the next chunk. The chunk may be freed after the call.
+    void push(const std::string_view chunk) {
+        if (error != nullptr) {
+            return;
+        }
+        read_chunk(chunk.data(), chunk.data() + chunk.size());
+        if (error != nullptr) {
+            errorOffset = pushedSize + (error - chunk.data());
+        }
+        pushedSize += chunk.size();
+    }
+    // Call after the last chunk, sets `error` if the document is incomplete.
+    void finish() {
+        if ((error == nullptr) & (step != steps::done)) {
+            error = ""; // not into the last chunk, it may be freed already
+            errorOffset = pushedSize;
+        }
+    }
+    // Prepares for the next document, the buffers keep their capacity.
+    void reset() {
+        error = nullptr;
+        errorOffset = 0;
+        pushedSize = 0;
+        step = steps::root;
+        pending = pendings::none;
+        for (level_t& it : levels) {
+            it.objectHandler = nullptr;
+            it.arrayHandler = nullptr;
+        }
+        depth = 0;
+        level = nullptr;
+        isPrevEscape = false;
+        isTokenBuffered = false;
+    }
+
+private:
+    enum class steps : uint8_t {
+        root,
+        next,
+        key,
+        colon,
+        value,
+        number,
+        string,
+        literal,
+        comment,
+        skip,
+        done,
+    };
+    // A container value whose handler is running.
+    enum class pendings : uint8_t {
+        none,
+        object,
+        array,
+        mismatch, // parse() with the other handler type
+    };
+    struct level_t {
+        object_handler_t objectHandler;
+        array_handler_t arrayHandler;
+        std::string key; // a copy if the value is in the next chunk
+        uint32_t index = 0;
+        bool isObject = false;
+    };
+
+    void read_chunk(const char* begin, const char* end) {
+        tokenBegin = begin;
+        for (; begin < end; ++begin) {
+            switch (step) {
+            case steps::root:
                 switch (*begin) {
-                case '"':
-                    step = steps::colon;
-                    //if (!handler) {
-                    //    break;
-                    //}
-                    if (isStringWithEscape) {
-                        key = keyStr;
+                case '{': case '[': {
+                    if (levels.empty()) {
+                        levels.emplace_back();
                     }
-                    else {
-                        key = std::string_view(beginStr, begin - beginStr);
-                    }
-                    break;
-                case '\\':
-                    isPrevEscape = true;
-                    if (!!handler & !isStringWithEscape) {
-                        isStringWithEscape = true;
-                        if (beginStr != begin) {
-                            keyStr = std::string(beginStr, begin - beginStr);
-                        }
-                    }
-                    break;
-                default:
-                    if (!!handler & isStringWithEscape) {
-                        keyStr.push_back(*begin);
+                    level_t& root = levels.front();
+                    root.index = 0;
+                    root.isObject = *begin == '{';
+                    if (root.isObject ? static_cast<bool>(root.arrayHandler)
+                            : static_cast<bool>(root.objectHandler)) {
+                        error = begin;
+                        return;
                     }
+                    depth = 1;
+                    level = &root;
+                    step = steps::next;
                     break;
                 }
-                break;
-            case steps::colon:
-                switch (*begin) {
-                case ':':
-                    step = steps::value;
-                    break;
-                case ' ': case '\t': case '\r': case '\n':
-                    break;
                 default:
-                    error = begin;
-                    return;
+                    break;
                 }
                 break;
-            case steps::value:
+            case steps::next:
                 switch (*begin) {
-                case '{': {
-                    value.emplace<object_idx>();
-                    auto beginBefore = ++begin;
-                    if (handler) {
-                        handler(key, value);
-                    }
-                    if (begin == beginBefore) {
-                        parse(std::function<void(key_t, const value_t&)>());
-                    }
-                    if (error != nullptr) {
-                        return;
-                    }
-                    step = steps::next;
+                case ',':
                     break;
-                }
-                case '[': {
-                    value.emplace<array_idx>();
-                    auto beginBefore = ++begin;
-                    if (handler) {
-                        handler(key, value);
-                    }
-                    if (begin == beginBefore) {
-                        parse(std::function<void(uint32_t, const value_t&)>());
-                    }
-                    if (error != nullptr) {
+                case '}': case ']':
+                    if ((*begin == '}') != level->isObject) {
+                        error = begin;
                         return;
                     }
-                    step = steps::next;
+                    close();
                     break;
-                }
                 case '"':
-                    step = steps::string;
-                    beginStr = begin + 1;
-                    isStringWithEscape = false;
+                    if (level->isObject) {
+                        step = steps::key;
+                        start_token(begin + 1);
+                        break;
+                    }
+                    step = steps::value;
+                    --begin;
                     break;
-                case '-': case '+':
-                case '0': case '1': case '2': case '3': case '4':
-                case '5': case '6': case '7': case '8': case '9':
-                    step = steps::number;
-                    beginStr = begin;
+                case '/':
+                    step = steps::comment;
                     break;
                 case ' ': case '\t': case '\r': case '\n':
+                    begin = cjwd_detail::skip_whitespace(begin + 1, end) - 1;
                     break;
                 default:
-                    if (end - begin >= 5) {
-                        if (std::string_view(begin, 4) == "null") {
-                            begin += 4 - 1;
-                            if (handler) {
-                                value.emplace<null_idx>();
-                                handler(key, value);
-                            }
-                            step = steps::next;
-                            break;
-                        }
-                        else if (std::string_view(begin, 4) == "true") {
-                            begin += 4 - 1;
-                            if (handler) {
-                                value.emplace<boolean_idx>(true);
-                                handler(key, value);
-                            }
-                            step = steps::next;
-                            break;
-                        }
-                        else if (std::string_view(begin, 5) == "false") {
-                            begin += 5 - 1;
-                            if (handler) {
-                                value.emplace<boolean_idx>(false);
-                                handler(key, value);
-                            }
-                            step = steps::next;
-                            break;
-                        }
-                    }
-                    error = begin;
-                    return;
-                }
-                break;
-            case steps::number:
-                switch (*begin) {
-                case '-': case '+':
-                case '0': case '1': case '2': case '3': case '4':
-                case '5': case '6': case '7': case '8': case '9':
-                case '.': case 'e': case 'E':
-                    break;
-                default:
-                    double v = 0.0;
-#                 if defined(CJWD_CPP_LIB_CHARCONV_FLOAT)
-                    auto [ptr, ec] = std::from_chars(beginStr, begin, v);
-                    if (ptr != begin || ec != std::errc()) {
-                        error = ptr;
-                        return;
-                    }
-#                 else
-                    char format[8];
-                    std::snprintf(format, sizeof(format), "%%%ulf",
-                        static_cast<uint32_t>(begin - beginStr));
-                    if (std::sscanf(beginStr, format, &v) != 1) {
-                        error = beginStr;
+                    if (level->isObject) {
+                        error = begin;
                         return;
                     }
-#                 endif
+                    step = steps::value;
                     --begin;
-                    if (handler) {
-                        value.emplace<number_idx>(v);
-                        handler(key, value);
-                    }
-                    step = steps::next;
                     break;
                 }
                 break;
-            case steps::string:
-                if (isPrevEscape) {
-                    isPrevEscape = false;
-                    if (handler) {
-                        valueStr.push_back(*begin);
-                    }
-                    break;
-                }
+            case steps::colon:
                 switch (*begin) {
-                case '"':
-                    if (handler) {
-                        if (isStringWithEscape) {
-                            value.emplace<string_idx>(valueStr);
-                        }
-                        else {
-                            value.emplace<string_idx>(std::string_view(beginStr, begin - beginStr));
-                        }
-                        handler(key, value);
-                        keyStr.clear();
-                        valueStr.clear();
-                    }
-                    step = steps::next;
-                    break;
-                case '\\':
-                    isPrevEscape = true;
-                    if (!!handler & !isStringWithEscape) {
-                        isStringWithEscape = true;
-                        if (beginStr != begin) {
-                            valueStr = std::string(beginStr, begin - beginStr);
-                        }
-                    }
-                    break;
-                default:
-                    if (!!handler & isStringWithEscape) {
-                        valueStr.push_back(*begin);
-                    }
+                case ':':
+                    step = steps::value;
                     break;
-                }
-                break;
-            case steps::comment:
-                switch (*begin) {
-                case '\r': case '\n':
-                    step = steps::next;
+                case ' ': case '\t': case '\r': case '\n':
+                    begin = cjwd_detail::skip_whitespace(begin + 1, end) - 1;
                     break;
                 default:
-                    break;
+                    error = begin;
+                    return;
                 }
                 break;
-            default:
-                break;
-            }
-        }
-        if (step == steps::string) {
-            error = begin;
-        }
-    }
-
-    void parse(std::function<void(uint32_t index, const value_t& value)> handler) {
-        if (error != nullptr) {
-            return;
-        }
-        enum class steps : uint8_t {
-            next,
-            number,
-            string,
-            comment,
-        } step = steps::next;
-
-        const char* beginStr = nullptr;
-        bool isPrevEscape = false;
-        bool isStringWithEscape = false;
-        uint32_t index = 0;
-        value_t value;
-        std::string valueStr;
-        for (; begin < end; ++begin) {
-            switch (step) {
-            case steps::next:
+            case steps::value:
                 switch (*begin) {
-                case ']':
-                    return;
-                case ',':
-                    break;
-                case '{': {
-                    value.emplace<object_idx>();
-                    auto beginBefore = ++begin;
-                    if (handler) {
-                        handler(index, value);
-                    }
-                    if (begin == beginBefore) {
-                        parse(std::function<void(key_t, const value_t&)>());
+                case '{': case '[': {
+                    const bool isObject = *begin == '{';
+                    if (isObject) {
+                        value.emplace<json_reader::object_idx>();
                     }
-                    if (error != nullptr) {
-                        return;
-                    }
-                    step = steps::next;
-                    ++index;
-                    break;
-                }
-                case '[': {
-                    value.emplace<array_idx>();
-                    auto beginBefore = ++begin;
-                    if (handler) {
-                        handler(index, value);
-                    }
-                    if (begin == beginBefore) {
-                        parse(std::function<void(uint32_t, const value_t&)>());
+                    else {
+                        value.emplace<json_reader::array_idx>();
                     }
-                    if (error != nullptr) {
+                    pending = isObject ? pendings::object : pendings::array;
+                    call_handler();
+                    switch (pending) {
+                    case pendings::none: // opened by parse
+                        break;
+                    case pendings::mismatch:
+                        error = begin;
                         return;
+                    default:
+                        pending = pendings::none;
+                        skipState = cjwd_detail::skip_state();
+                        step = steps::skip;
+                        break;
                     }
-                    step = steps::next;
-                    ++index;
-                    break;
-                }
-                case '-': case '+':
-                case '0': case '1': case '2': case '3': case '4':
-                case '5': case '6': case '7': case '8': case '9':
-                    step = steps::number;
-                    beginStr = begin;
-                    break;
-                case '"':
-                    step = steps::string;
-                    beginStr = begin + 1;
-                    isStringWithEscape = false;
-                    break;
-                case '/':
-                    step = steps::comment;
-                    beginStr = begin;
-                    break;
-                case ' ': case '\t': case '\r': case '\n':
-                    break;
-                default:
-                    if (end - begin >= 5) {
-                        if (std::string_view(begin, 4) == "null") {
-                            begin += 4 - 1;
-                            if (handler) {
-                                value.emplace<null_idx>();
-                                handler(index, value);
-                            }
-                            step = steps::next;
-                            ++index;
-                            break;
-                        }
-                        else if (std::string_view(begin, 4) == "true") {
-                            begin += 4 - 1;
-                            if (handler) {
-                                value.emplace<boolean_idx>(true);
-                                handler(index, value);
-                            }
-                            step = steps::next;
-                            ++index;
-                            break;
-                        }
-                        else if (std::string_view(begin, 5) == "false") {
-                            begin += 5 - 1;
-                            if (handler) {
-                                value.emplace<boolean_idx>(false);
-                                handler(index, value);
-                            }
-                            step = steps::next;
-                            ++index;
-                            break;
-                        }
-                    }
+                    break;
+                }
+                case '"':
+                    step = steps::string;
+                    start_token(begin + 1);
+                    break;
+                case '-': case '+':
+                case '0': case '1': case '2': case '3': case '4':
+                case '5': case '6': case '7': case '8': case '9':
+                    step = steps::number;
+                    start_token(begin);
+                    isFloatNumber = false;
+                    break;
+                case 'n': case 't': case 'f':
+                    step = steps::literal;
+                    start_token(begin);
+                    break;
+                case ' ': case '\t': case '\r': case '\n':
+                    begin = cjwd_detail::skip_whitespace(begin + 1, end) - 1;
+                    break;
+                default:
                     error = begin;
                     return;
                 }
                 break;
+            case steps::key:
+            case steps::string: {
+                if (isPrevEscape) {
+                    isPrevEscape = false;
+                    break;
+                }
+                const char* found = cjwd_detail::find_quote_or_escape(begin, end);
+                if (found == end) {
+                    begin = end - 1;
+                    break;
+                }
+                begin = found;
+                if (*begin == '\\') {
+                    isStringWithEscape = true;
+                    isPrevEscape = true;
+                    break;
+                }
+                std::string_view str = take_token(begin);
+                if (isStringWithEscape) {
+                    if (str.data() != token.data()) {
+                        token.assign(str.data(), str.size());
+                    }
+                    const char* strEnd = cjwd_detail::unescape_in_place(&token[0], &token[0] + token.size());
+                    if (strEnd == nullptr) {
+                        error = begin;
+                        return;
+                    }
+                    str = std::string_view(token.data(), strEnd - token.data());
+                }
+                if (step == steps::key) {
+                    key = str;
+                    isKeyOwned = str.data() == token.data(); // reused by the value
+                    if (isKeyOwned) {
+                        level->key.assign(str.data(), str.size());
+                        key = level->key;
+                    }
+                    step = steps::colon;
+                    break;
+                }
+                value.emplace<json_reader::string_idx>(str);
+                call_handler();
+                step = steps::next;
+                break;
+            }
             case steps::number:
                 switch (*begin) {
-                case '-': case '+':
                 case '0': case '1': case '2': case '3': case '4':
                 case '5': case '6': case '7': case '8': case '9':
+                    begin = cjwd_detail::skip_digits(begin + 1, end) - 1;
+                    break;
+                case '-': case '+':
+                    break;
                 case '.': case 'e': case 'E':
+                    isFloatNumber = true;
                     break;
-                default:
-                    double v = 0.0;
-#                 if defined(CJWD_CPP_LIB_CHARCONV_FLOAT)
-                    auto [ptr, ec] = std::from_chars(beginStr, begin, v);
-                    if (ptr != begin || ec != std::errc()) {
-                        error = ptr;
-                        return;
-                    }
-#                 else
-                    char format[8];
-                    std::snprintf(format, sizeof(format), "%%%ulf",
-                        static_cast<uint32_t>(begin - beginStr));
-                    if (std::sscanf(beginStr, format, &v) != 1) {
-                        error = beginStr;
+                default: {
+                    const std::string_view number = take_token(begin);
+                    if (json_reader::parse_number(number.data(), number.data() + number.size(),
+                            isFloatNumber, value) != nullptr) {
+                        error = begin;
                         return;
                     }
-#                 endif
                     --begin;
-                    if (handler) {
-                        value.emplace<number_idx>(v);
-                        handler(index, value);
-                    }
+                    call_handler();
                     step = steps::next;
-                    ++index;
                     break;
                 }
+                }
                 break;
-            case steps::string:
-                if (isPrevEscape) {
-                    isPrevEscape = false;
-                    if (handler) {
-                        valueStr.push_back(*begin);
-                    }
+            case steps::literal: {
+                if ((*begin >= 'a') & (*begin <= 'z')) {
                     break;
                 }
-                switch (*begin) {
-                case '"':
-                    if (handler) {
-                        if (isStringWithEscape) {
-                            value.emplace<string_idx>(valueStr);
-                        }
-                        else {
-                            value.emplace<string_idx>(std::string_view(beginStr, begin - beginStr));
-                        }
-                        handler(index, value);
-                        valueStr.clear();
-                    }
-                    step = steps::next;
-                    ++index;
-                    break;
-                case '\\':
-                    isPrevEscape = true;
-                    if (!!handler & !isStringWithEscape) {
-                        isStringWithEscape = true;
-                        if (beginStr != begin) {
-                            valueStr = std::string(beginStr, begin - beginStr);
-                        }
-                    }
-                    break;
-                default:
-                    if (!!handler & isStringWithEscape) {
-                        valueStr.push_back(*begin);
-                    }
-                    break;
+                const std::string_view literal = take_token(begin);
+                if (literal == "null") {
+                    value.emplace<json_reader::null_idx>();
+                }
+                else if (literal == "true") {
+                    value.emplace<json_reader::boolean_idx>(true);
+                }
+                else if (literal == "false") {
+                    value.emplace<json_reader::boolean_idx>(false);
+                }
+                else {
+                    error = begin;
+                    return;
                 }
+                --begin;
+                call_handler();
+                step = steps::next;
                 break;
+            }
             case steps::comment:
                 switch (*begin) {
                 case '\r': case '\n':
@@ -629,15 +5954,431 @@ struct json_reader {
                     break;
                 }
                 break;
-            default:
+            case steps::skip:
+                begin = cjwd_detail::skip_container(begin, end, skipState);
+                if (begin == end) {
+                    --begin;
+                    break;
+                }
+                step = steps::next;
                 break;
+            case steps::done:
+                return;
             }
         }
-        if (step == steps::string) {
-            error = begin;
+        switch (step) {
+        case steps::key:
+        case steps::string:
+        case steps::number:
+        case steps::literal:
+            if (isTokenBuffered) {
+                token.append(tokenBegin, end);
+            }
+            else {
+                token.assign(tokenBegin, end);
+                isTokenBuffered = true;
+            }
+            break;
+        default:
+            break;
+        }
+        // The key is needed by a value in the next chunk
+        const bool isKeyNeeded = (step == steps::colon) | (step == steps::value)
+            | (step == steps::number) | (step == steps::string) | (step == steps::literal);
+        if ((depth != 0) && level->isObject && !isKeyOwned & isKeyNeeded) {
+            level->key.assign(key.data(), key.size());
+            key = level->key;
+            isKeyOwned = true;
+        }
+    }
+    void open(const bool isObject, object_handler_t objectHandler, array_handler_t arrayHandler) {
+        if (step == steps::root) {
+            if (levels.empty()) {
+                levels.emplace_back();
+            }
+            levels.front().objectHandler = std::move(objectHandler);
+            levels.front().arrayHandler = std::move(arrayHandler);
+            return;
+        }
+        if ((pending == pendings::none) | (pending == pendings::mismatch)) {
+            return;
+        }
+        if (isObject != (pending == pendings::object)) {
+            pending = pendings::mismatch;
+            return;
+        }
+        pending = pendings::none;
+        if (depth == levels.size()) {
+            levels.emplace_back(); // a deque keeps running handlers in place
+        }
+        level = &levels[depth++];
+        level->objectHandler = std::move(objectHandler);
+        level->arrayHandler = std::move(arrayHandler);
+        level->index = 0;
+        level->isObject = isObject;
+        step = steps::next;
+    }
+    void close() {
+        level->objectHandler = nullptr;
+        level->arrayHandler = nullptr;
+        --depth;
+        level = depth == 0 ? nullptr : &levels[depth - 1];
+        step = depth == 0 ? steps::done : steps::next;
+    }
+    void call_handler() {
+        if (level->isObject) {
+            if (level->objectHandler) {
+                level->objectHandler(key, value);
+            }
+        }
+        else {
+            const uint32_t index = level->index++;
+            if (level->arrayHandler) {
+                level->arrayHandler(index, value);
+            }
+        }
+    }
+    void start_token(const char* begin) {
+        tokenBegin = begin;
+        isTokenBuffered = false;
+        isStringWithEscape = false;
+    }
+    // Returns the token that ends at `end`, with its part from previous chunks.
+    std::string_view take_token(const char* end) {
+        if (isTokenBuffered) {
+            isTokenBuffered = false;
+            token.append(tokenBegin, end);
+            return token;
+        }
+        return std::string_view(tokenBegin, end - tokenBegin);
+    }
+
+    std::deque<level_t> levels;
+    level_t* level = nullptr; // levels[depth - 1]
+    size_t depth = 0;
+    key_t key;
+    value_t value;
+    std::string token; // a token split between chunks, or an escaped string
+    const char* tokenBegin = nullptr;
+    uint64_t pushedSize = 0;
+    cjwd_detail::skip_state skipState;
+    steps step = steps::root;
+    pendings pending = pendings::none;
+    bool isPrevEscape = false;
+    bool isStringWithEscape = false;
+    bool isTokenBuffered = false;
+    bool isFloatNumber = false;
+    bool isKeyOwned = false;
+};
+
+#if !defined(CJWD_NO_THREADS)
+// Parses JSON Lines (NDJSON) or a huge root array on several threads,
+// available if `CJWD_THREADS` is defined.
+// The input is cut at line ends or between elements into chunks of about
+// `chunkSize` bytes, which are shared between the workers, and an idle worker
+// steals chunks from the others. Every worker has its own json_reader, so its
+// scratch arena is reused from chunk to chunk. Handlers must not throw.
+// `reader.stop()` in a handler stops the whole parse: the records and elements
+// that are not started yet are not parsed, the ones in progress on other
+// threads are finished.
+struct json_parallel_reader {
+    uint32_t threads = 0; // 0 - std::thread::hardware_concurrency()
+    size_t chunkSize = 1 << 20;
+    const char* error = nullptr; // the first error of parse_array()
+
+    // Whether the last parse was ended by `reader.stop()`, `error` stays nullptr.
+    bool is_stopped() const {
+        return isStopped;
+    }
+
+    // Calls `handler(uint64_t ordinal, json_reader& reader)` for each record
+    // from the worker threads in any order, concurrently. A record is a line
+    // with a document, empty lines and comment lines are not counted. The
+    // reader is set to the record, the handler parses it and can check
+    // `reader.error` then.
+    template <typename handler_t>
+    void parse_lines(const std::string_view input, handler_t&& handler) {
+        error = nullptr;
+        std::vector<chunk_t> chunks = split(input);
+        std::vector<json_reader> readers(workers_number(chunks.size()));
+        std::atomic<bool> isAnyStopped(false);
+        auto task = [&](const size_t index, const uint32_t worker) {
+            for_each_line(chunks[index], readers[worker], isAnyStopped, handler);
+        };
+        run(chunks.size(), task, [] {});
+        isStopped = isAnyStopped;
+    }
+    // Calls `result = parser(uint64_t ordinal, json_reader& reader)` for each
+    // record from the worker threads, and `consumer(uint64_t ordinal, result)`
+    // from this thread in the order of records. Results of a chunk are kept
+    // until all the previous chunks are consumed.
+    template <typename parser_t, typename consumer_t>
+    void parse_lines_ordered(const std::string_view input,
+            parser_t&& parser, consumer_t&& consumer) {
+        using result_t = typename std::decay<decltype(
+            parser(uint64_t(), std::declval<json_reader&>()))>::type;
+        error = nullptr;
+        std::vector<chunk_t> chunks = split(input);
+        std::vector<json_reader> readers(workers_number(chunks.size()));
+        std::vector<std::vector<result_t>> results(chunks.size());
+        std::vector<bool> isDone(chunks.size(), false);
+        std::mutex mutex;
+        std::condition_variable doneEvent;
+        std::atomic<bool> isAnyStopped(false);
+        auto task = [&](const size_t index, const uint32_t worker) {
+            std::vector<result_t>& chunkResults = results[index];
+            chunkResults.reserve(chunks[index].count);
+            for_each_line(chunks[index], readers[worker], isAnyStopped,
+                [&](const uint64_t ordinal, json_reader& reader) {
+                    chunkResults.push_back(parser(ordinal, reader));
+                });
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                isDone[index] = true;
+            }
+            doneEvent.notify_all();
+        };
+        auto consume = [&] {
+            for (size_t index = 0; index < chunks.size(); ++index) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    doneEvent.wait(lock, [&] { return isDone[index]; });
+                }
+                uint64_t ordinal = chunks[index].firstOrdinal;
+                for (result_t& result : results[index]) {
+                    consumer(ordinal++, result);
+                }
+                std::vector<result_t>().swap(results[index]);
+            }
+        };
+        run(chunks.size(), task, consume);
+        isStopped = isAnyStopped;
+    }
+    // Calls `handler(uint32_t index, const json_reader::value_t& value,
+    // json_reader& reader)` for each element of the root array from the worker
+    // threads in any order, concurrently. Nested objects and arrays are parsed
+    // with `reader` as in json_reader. The array is cut between elements by a
+    // vectorized structural pass, like skip(), before the workers start.
+    template <typename handler_t>
+    void parse_array(const std::string_view input, handler_t&& handler) {
+        error = nullptr;
+        std::vector<chunk_t> batches = split_array(input);
+        std::vector<json_reader> readers(workers_number(batches.size()));
+        std::vector<const char*> errors(batches.size(), nullptr);
+        std::atomic<bool> isAnyStopped(false);
+        auto task = [&](const size_t index, const uint32_t worker) {
+            if (isAnyStopped.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const chunk_t& batch = batches[index];
+            const uint32_t firstIndex = static_cast<uint32_t>(batch.firstOrdinal);
+            json_reader& reader = readers[worker];
+            reader.reset_array(batch.begin, batch.end);
+            reader.parse([&](const uint32_t i, const json_reader::value_t& value) {
+                if (isAnyStopped.load(std::memory_order_relaxed)) {
+                    reader.stop();
+                    return;
+                }
+                handler(firstIndex + i, value, reader);
+            });
+            if (reader.is_stopped()) {
+                isAnyStopped.store(true, std::memory_order_relaxed);
+            }
+            // A batch before the last one ends after a comma, not at the bracket.
+            const bool isCut = index + 1 < batches.size();
+            errors[index] = isCut && (reader.error == batch.end) ? nullptr : reader.error;
+        };
+        run(batches.size(), task, [] {});
+        isStopped = isAnyStopped;
+        for (const char* errorAt : errors) {
+            if (errorAt != nullptr) {
+                error = errorAt;
+                break;
+            }
+        }
+    }
+
+private:
+    struct chunk_t {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        uint64_t firstOrdinal = 0;
+        uint64_t count = 0;
+    };
+    struct queue_t {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+    bool isStopped = false;
+
+    static const char* line_end(const char* begin, const char* end) {
+        const void* newline = std::memchr(begin, '\n', end - begin);
+        return newline != nullptr ? static_cast<const char*>(newline) : end;
+    }
+    static bool is_record(const char* begin, const char* end) {
+        begin = cjwd_detail::skip_whitespace(begin, end);
+        return (begin < end) && (*begin != '/');
+    }
+    template <typename handler_t>
+    static void for_each_line(const chunk_t& chunk, json_reader& reader,
+            std::atomic<bool>& isAnyStopped, handler_t&& handler) {
+        uint64_t ordinal = chunk.firstOrdinal;
+        for (const char* begin = chunk.begin; begin < chunk.end; ) {
+            const char* end = line_end(begin, chunk.end);
+            if (is_record(begin, end)) {
+                if (isAnyStopped.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                reader = std::string_view(begin, end - begin);
+                handler(ordinal++, reader);
+                if (reader.is_stopped()) {
+                    isAnyStopped.store(true, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            begin = end + 1;
+        }
+    }
+
+    uint32_t workers_number(const size_t tasks) const {
+        uint32_t number = threads;
+        if (number == 0) {
+            number = std::thread::hardware_concurrency();
+        }
+        if (number > tasks) {
+            number = static_cast<uint32_t>(tasks);
+        }
+        return number > 0 ? number : 1;
+    }
+    // Cuts the input into chunks and numbers the records, counting them on
+    // the workers too, since it is a pass over the whole input.
+    std::vector<chunk_t> split(const std::string_view input) {
+        std::vector<chunk_t> chunks;
+        const size_t size = chunkSize > 0 ? chunkSize : 1;
+        const char* end = input.data() + input.size();
+        for (const char* begin = input.data(); begin < end; ) {
+            chunk_t chunk;
+            chunk.begin = begin;
+            chunk.end = static_cast<size_t>(end - begin) > size
+                ? line_end(begin + size, end) : end;
+            if (chunk.end < end) {
+                ++chunk.end; // with `\n`
+            }
+            chunks.push_back(chunk);
+            begin = chunk.end;
+        }
+        auto count = [&chunks](const size_t index, uint32_t) {
+            chunk_t& chunk = chunks[index];
+            for (const char* begin = chunk.begin; begin < chunk.end; ) {
+                const char* end = line_end(begin, chunk.end);
+                chunk.count += is_record(begin, end);
+                begin = end + 1;
+            }
+        };
+        run(chunks.size(), count, [] {});
+        uint64_t ordinal = 0;
+        for (chunk_t& chunk : chunks) {
+            chunk.firstOrdinal = ordinal;
+            ordinal += chunk.count;
+        }
+        return chunks;
+    }
+    // Cuts the root array after a comma at depth 1 every `chunkSize` bytes.
+    // A batch includes the comma or the closing bracket, `firstOrdinal` is the
+    // index of its first element. Only the cuts are sequential, the elements
+    // are counted on the workers.
+    std::vector<chunk_t> split_array(const std::string_view input) {
+        std::vector<chunk_t> batches;
+        json_reader root;
+        root = input;
+        if (!root.is_array()) {
+            error = root.error != nullptr ? root.error : root.begin - 1;
+            return batches;
+        }
+        const size_t size = chunkSize > 0 ? chunkSize : 1;
+        const char* end = input.data() + input.size();
+        cjwd_detail::skip_state state;
+        uint64_t commas = 0;
+        chunk_t batch;
+        batch.begin = root.begin;
+        while (true) {
+            const char* limit = static_cast<size_t>(end - batch.begin) > size
+                ? batch.begin + size : end;
+            const char* found = cjwd_detail::skip_container(batch.begin, limit, state);
+            if (found == limit) {
+                found = cjwd_detail::index_container(limit, end, state, commas, true);
+            }
+            batch.end = found < end ? found + 1 : end;
+            batches.push_back(batch);
+            if ((found == end) || (*found != ',')) {
+                break;
+            }
+            batch.begin = found + 1;
+        }
+        auto count = [&batches](const size_t index, uint32_t) {
+            chunk_t& batch = batches[index];
+            cjwd_detail::skip_state state;
+            cjwd_detail::index_container(batch.begin, batch.end, state, batch.count, false);
+        };
+        run(batches.size(), count, [] {});
+        uint64_t ordinal = 0;
+        for (chunk_t& batch : batches) {
+            batch.firstOrdinal = ordinal;
+            ordinal += batch.count;
+        }
+        return batches;
+    }
+    // Runs `task(index, worker)` for each index on the worker threads, and
+    // `wait()` on this thread meanwhile. Each worker starts with a contiguous
+    // range of indices and takes them from the front, a worker without tasks
+    // steals from the back of another one.
+    template <typename task_t, typename wait_t>
+    void run(const size_t count, task_t& task, wait_t&& wait) {
+        if (count == 0) {
+            wait();
+            return;
+        }
+        const uint32_t workers = workers_number(count);
+        std::vector<queue_t> queues(workers);
+        for (size_t index = 0; index < count; ++index) {
+            queues[index * workers / count].tasks.push_back(index);
+        }
+        auto take = [&queues, workers](const uint32_t worker, size_t& index) {
+            for (uint32_t i = 0; i < workers; ++i) {
+                queue_t& queue = queues[(worker + i) % workers];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) {
+                    continue;
+                }
+                if (i == 0) {
+                    index = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+                else {
+                    index = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+                return true;
+            }
+            return false;
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (uint32_t worker = 0; worker < workers; ++worker) {
+            pool.emplace_back([&task, &take, worker] {
+                size_t index = 0;
+                while (take(worker, index)) {
+                    task(index, worker);
+                }
+            });
+        }
+        wait();
+        for (std::thread& thread : pool) {
+            thread.join();
         }
     }
 };
+#endif // CJWD_NO_THREADS
 
 struct json_writer {
 private:
@@ -725,55 +6466,90 @@ public:
 
     struct object_t;
     struct array_t;
+private:
+    template <typename json_t, typename handler_t>
+    struct is_handler {
+        template <typename T>
+        static auto check(int) -> decltype(std::declval<T&>()(std::declval<json_t>()), std::true_type());
+        template <typename T>
+        static std::false_type check(...);
+        static constexpr bool value = decltype(check<
+            typename std::remove_reference<handler_t>::type>(0))::value;
+    };
+    template <typename handler_t>
+    static auto has_handler(const handler_t& handler, int) -> decltype(static_cast<bool>(handler)) {
+        return static_cast<bool>(handler);
+    }
+    template <typename handler_t>
+    static bool has_handler(const handler_t&, long) {
+        return true;
+    }
+    template <typename json_t, typename handler_t>
+    void nested(const char open, const char close, handler_t& handler, const flags flags_) {
+        tab(false, false);
+        buffer.push_back(open);
+
+        if (has_handler(handler, 0)) {
+            ++level;
+            if ((flags_ == flags::single_line) & !singleLine) {
+                singleLine = true;
+                handler(json_t(this));
+                --level;
+                tab(true, false);
+                buffer.pop_back();
+                singleLine = false;
+            }
+            else {
+                handler(json_t(this));
+                --level;
+                tab(true, false);
+            }
+        }
+        buffer.push_back(close);
+        buffer.push_back(',');
+        lastComma = buffer.size() - 1;
+    }
+    template <typename json_t, typename handler_t>
+    void root(const char open, const char close, handler_t& handler, const flags flags_) {
+        buffer.clear();
+        buffer.push_back(open);
+
+        if (flags_ == flags::single_line) {
+            singleLine = true;
+        }
+        else {
+            singleLine = false;
+        }
+        if (has_handler(handler, 0)) {
+            ++level;
+            handler(json_t(this));
+            --level;
+        }
+        tab(true, false);
+        buffer.push_back(close);
+    }
+public:
     struct value_t {
+        template <typename handler_t, typename std::enable_if<
+            is_handler<object_t, handler_t>::value, int>::type = 0>
+        object_t object(handler_t&& handler, const flags flags_ = flags::none) {
+            writer->nested<object_t>('{', '}', handler, flags_);
+            return { writer };
+        }
         object_t object(std::function<void(object_t json)> handler,
                 const flags flags_ = flags::none) {
-            writer->tab(false, false);
-            writer->buffer.push_back('{');
-
-            if (handler) {
-                ++writer->level;
-                if ((flags_ == flags::single_line) & !writer->singleLine) {
-                    writer->singleLine = true;
-                    handler({ writer });
-                    --writer->level;
-                    writer->tab(true, false);
-                    writer->buffer.pop_back();
-                    writer->singleLine = false;
-                }
-                else {
-                    handler({ writer });
-                    --writer->level;
-                    writer->tab(true, false);
-                }
-            }
-            writer->append("},");
-            writer->lastComma = writer->buffer.size() - 1;
+            writer->nested<object_t>('{', '}', handler, flags_);
+            return { writer };
+        }
+        template <typename handler_t, typename std::enable_if<
+            is_handler<array_t, handler_t>::value, int>::type = 0>
+        object_t array(handler_t&& handler, const flags flags_ = flags::none) {
+            writer->nested<array_t>('[', ']', handler, flags_);
             return { writer };
         }
         object_t array(std::function<void(array_t json)> handler,
                 const flags flags_ = flags::none) {
-            writer->tab(false, false);
-            writer->buffer.push_back('[');
-
-            if (handler) {
-                ++writer->level;
-                if ((flags_ == flags::single_line) & !writer->singleLine) {
-                    writer->singleLine = true;
-                    handler({ writer });
-                    --writer->level;
-                    writer->tab(true, false);
-                    writer->buffer.pop_back();
-                    writer->singleLine = false;
-                }
-                else {
-                    handler({ writer });
-                    --writer->level;
-                    writer->tab(true, false);
-                }
-            }
-            writer->append("],");
-            writer->lastComma = writer->buffer.size() - 1;
+            writer->nested<array_t>('[', ']', handler, flags_);
             return { writer };
         }
         template <typename bool_t,
@@ -871,54 +6647,26 @@ public:
         json_writer* writer = nullptr;
     };
     struct array_t {
+        template <typename handler_t, typename std::enable_if<
+            is_handler<object_t, handler_t>::value, int>::type = 0>
+        array_t& object(handler_t&& handler, const flags flags_ = flags::none) {
+            writer->nested<object_t>('{', '}', handler, flags_);
+            return *this;
+        }
         array_t& object(std::function<void(object_t json)> handler,
                 const flags flags_ = flags::none) {
-            writer->tab(false, false);
-            writer->buffer.push_back('{');
-
-            if (handler) {
-                ++writer->level;
-                if ((flags_ == flags::single_line) & !writer->singleLine) {
-                    writer->singleLine = true;
-                    handler({ writer });
-                    --writer->level;
-                    writer->tab(true, false);
-                    writer->buffer.pop_back();
-                    writer->singleLine = false;
-                }
-                else {
-                    handler({ writer });
-                    --writer->level;
-                    writer->tab(true, false);
-                }
-            }
-            writer->append("},");
-            writer->lastComma = writer->buffer.size() - 1;
+            writer->nested<object_t>('{', '}', handler, flags_);
+            return *this;
+        }
+        template <typename handler_t, typename std::enable_if<
+            is_handler<array_t, handler_t>::value, int>::type = 0>
+        array_t& array(handler_t&& handler, const flags flags_ = flags::none) {
+            writer->nested<array_t>('[', ']', handler, flags_);
             return *this;
         }
         array_t& array(std::function<void(array_t json)> handler,
                 const flags flags_ = flags::none) {
-            writer->tab(false, false);
-            writer->buffer.push_back('[');
-
-            if (handler) {
-                ++writer->level;
-                if ((flags_ == flags::single_line) & !writer->singleLine) {
-                    writer->singleLine = true;
-                    handler(*this);
-                    --writer->level;
-                    writer->tab(true, false);
-                    writer->buffer.pop_back();
-                    writer->singleLine = false;
-                }
-                else {
-                    handler(*this);
-                    --writer->level;
-                    writer->tab(true, false);
-                }
-            }
-            writer->append("],");
-            writer->lastComma = writer->buffer.size() - 1;
+            writer->nested<array_t>('[', ']', handler, flags_);
             return *this;
         }
         template <typename bool_t,
@@ -1005,44 +6753,27 @@ public:
         json_writer* writer = nullptr;
     };
 
+    // Handlers with a static type (lambdas, functors) are inlined into the writer.
+    template <typename handler_t, typename std::enable_if<
+        is_handler<object_t, handler_t>::value, int>::type = 0>
+    object_t object(handler_t&& handler, const flags flags_ = flags::none) {
+        root<object_t>('{', '}', handler, flags_);
+        return { this };
+    }
     object_t object(std::function<void(object_t json)> handler,
             const flags flags_ = flags::none) {
-        buffer.clear();
-        buffer.push_back('{');
-
-        if (flags_ == flags::single_line) {
-            singleLine = true;
-        }
-        else {
-            singleLine = false;
-        }
-        if (handler) {
-            ++level;
-            handler({ this });
-            --level;
-        }
-        tab(true, false);
-        buffer.push_back('}');
+        root<object_t>('{', '}', handler, flags_);
+        return { this };
+    }
+    template <typename handler_t, typename std::enable_if<
+        is_handler<array_t, handler_t>::value, int>::type = 0>
+    array_t array(handler_t&& handler, const flags flags_ = flags::none) {
+        root<array_t>('[', ']', handler, flags_);
         return { this };
     }
     array_t array(std::function<void(array_t json)> handler,
             const flags flags_ = flags::none) {
-        buffer.clear();
-        buffer.push_back('[');
-
-        if (flags_ == flags::single_line) {
-            singleLine = true;
-        }
-        else {
-            singleLine = false;
-        }
-        if (handler) {
-            ++level;
-            handler({ this });
-            --level;
-        }
-        tab(true, false);
-        buffer.push_back(']');
+        root<array_t>('[', ']', handler, flags_);
         return { this };
     }
 };
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../cpp_json_without_dom.hpp"
+
+// Usage: bench_large_file [size in MiB, 256 by default] [path]
+// Generates a file of objects and parses it after reading it into
+// a std::string, and directly from a json_file mapping.
+
+void generate(const char* path, const size_t size) {
+    std::ofstream file(path, std::ios::binary);
+    file << "[\n";
+    size_t written = 2;
+    for (uint32_t i = 0; written < size; ++i) {
+        json_writer writer;
+        writer.object([&](json_writer::object_t json) {
+            json
+            .key("id").value(i)
+            .key("name").value("user \"" + std::to_string(i) + "\"")
+            .key("score").value(i * 0.25)
+            .key("tags").array([](json_writer::array_t json) {
+                json.value("alpha").value("beta").value("gamma");
+            }, json_writer::flags::single_line);
+        }, json_writer::flags::single_line);
+        file << (i > 0 ? ",\n" : "") << writer.buffer;
+        written += writer.buffer.size() + 2;
+    }
+    file << "\n]\n";
+}
+
+uint64_t parse(const std::string_view input) {
+    uint64_t chsum = 0;
+    json_reader reader;
+    reader = input;
+    reader.parse([&](uint32_t, const json_reader::value_t&) {
+        reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            if (key == "id") {
+                chsum += value.as_uint64();
+            }
+            else if (key == "name") {
+                chsum += value.as_string().size();
+            }
+        });
+    });
+    if (reader.error != nullptr) {
+        std::cout << "error at " << reader.error - input.data() << std::endl;
+    }
+    return chsum;
+}
+
+template <typename function_t>
+void measure(const char* name, const size_t size, function_t&& function) {
+    const auto begin = std::chrono::steady_clock::now();
+    const uint64_t chsum = function();
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - begin).count();
+    std::cout << name << ": " << seconds * 1000.0 << " ms, "
+        << size / seconds / (1024 * 1024) << " MiB/s, chsum " << chsum << std::endl;
+}
+
+int32_t main(int32_t argc, char** argv) {
+    const size_t size = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256) * 1024 * 1024;
+    const char* path = argc > 2 ? argv[2] : "cjwd_large_file.json";
+    generate(path, size);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        measure("std::string", size, [&]() -> uint64_t {
+            std::ifstream file(path, std::ios::binary);
+            std::ostringstream stream;
+            stream << file.rdbuf();
+            const std::string input = std::move(stream).str();
+            return parse(input);
+        });
+        measure("json_file  ", size, [&]() -> uint64_t {
+            json_file file(path);
+            return parse(file.view());
+        });
+    }
+    std::remove(path);
+    return 0;
+}
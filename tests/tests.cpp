@@ -1,9 +1,20 @@
 #include <sstream>
 #include <iostream>
+#include <fstream>
 #include <iomanip>
 #include <chrono>
 #include <array>
 #include <vector>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
 
 #include "switch-str/switch_str.hpp"
 #include "cpp-adaptive-benchmark/benchmark.hpp"
@@ -41,6 +52,13 @@ static_assert(static_cast<uint8_t>(u8"🌍"[1]) == 0x9F, "Wrong UTF-8 config");
 static_assert(static_cast<uint8_t>(u8"🌍"[2]) == 0x8C, "Wrong UTF-8 config");
 static_assert(static_cast<uint8_t>(u8"🌍"[3]) == 0x8D, "Wrong UTF-8 config");
 
+struct raw_policy : json_reader_policy {
+    static constexpr bool decodeEscapes = false;
+};
+struct unique_policy : json_reader_policy {
+    static constexpr bool uniqueKeys = true;
+};
+
 void test() {
     json_writer writer;
     json_reader reader;
@@ -372,178 +390,1572 @@ void test() {
         reader.parse(std::function<void(json_reader::key_t, const json_reader::value_t&)>());
         assert(reader.error == nullptr);
     }
-    std::cout << "All the tests passed successfully." << std::endl;
-}
-
-void benchmark() {
-    constexpr std::string_view addressbookJson =
-        R"([)"
-        R"(    {)"
-        R"(        "name": "Alice",)"
-        R"(        "id": 123,)"
-        R"(        "email": "alice@example.com",)"
-        R"(        "phones": [)"
-        R"(            { "number": "555-1212", "type": "MOBILE" })"
-        R"(        ],)"
-        R"(        "ignore": { "ignore": null },)"
-        R"(        "employment": {)"
-        R"(            "variant": "school",)"
-        R"(            "text": "MIT")"
-        R"(        })"
-        R"(    },)"
-        R"(    {)"
-        R"(        "name": "Bob",)"
-        R"(        "id": 456,)"
-        R"(        "email": "bob@example.com",)"
-        R"(        "phones": [)"
-        R"(            { "number": "555-4567", "type": "HOME" },)"
-        R"(            { "number": "555-7654", "type": "WORK" })"
-        R"(        ],)"
-        R"(        "employment": {)"
-        R"(            "variant": "unemployed")"
-        R"(        })"
-        R"(    })"
-        R"(])";
-    struct Person {
-        std::string name;
-        uint32_t id;
-        std::string email;
-        struct Phone {
-            std::string number;
-            std::string type;
-        };
-        std::vector<Phone> phones;
-        struct Employment {
-            std::string variant;
-            std::string text;
-        };
-        Employment employment;
-    };
-    const std::initializer_list<Person> addressbookData = {
-        {
-            "Alice",
-            123,
-            "alice@example.com",
-            {
-                { "555-1212", "MOBILE" }
-            },
-            {
-                "school", "MIT"
+    {
+        // Type-erased handlers
+        reader = R"({ "aa": [ 1, { "bb": 2 } ], "cc": 3 })";
+        assert(reader.is_object());
+        uint32_t count = 0;
+        std::function<void(uint32_t, const json_reader::value_t&)> arrayHandler =
+            [&](uint32_t index, const json_reader::value_t& value) {
+                ++count;
+                assert(index != 0 || value.as_number() == 1);
+                assert(index != 1 || value.is_object());
+            };
+        reader.parse(std::function<void(json_reader::key_t, const json_reader::value_t&)>(
+            [&](json_reader::key_t key, const json_reader::value_t& value) {
+                ++count;
+                if (key == "aa") {
+                    reader.parse(arrayHandler);
+                }
+                else {
+                    assert(key == "cc");
+                    assert(value.as_number() == 3);
+                }
             }
-        },
-        {
-            "Bob",
-            456,
-            "bob@example.com",
-            {
-                { "555-4567", "HOME" },
-                { "555-7654", "WORK" }
-            },
-            {
-                "unemployed", std::string()
+        ));
+        assert(count == 4);
+        assert(reader.error == nullptr);
+    }
+    {
+        // Long strings with escapes around SIMD block boundaries
+        std::vector<std::string> strings;
+        for (uint32_t length = 0; length < 150; ++length) {
+            std::string string(length, 'x');
+            for (uint32_t i = 0; i < length; i += 1 + length / 3) {
+                string[i] = i % 2 ? '"' : '\\';
             }
+            strings.push_back(std::move(string));
         }
-    };
-
-    Benchmark bench;
-    bench.setColumnsNumber(2);
+        writer.object([&](json_writer::object_t json) {
+            for (const auto& string : strings) {
+                json.key(string).value(string);
+            }
+        });
+        reader = writer.buffer;
+        assert(reader.is_object());
+        uint32_t index = 0;
+        reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            assert(key == strings[index]);
+            assert(value.as_string() == strings[index]);
+            ++index;
+        });
+        assert(index == strings.size());
+        assert(reader.error == nullptr);
+    }
+    {
+        // Unescaped strings in a shared scratch arena
+        const std::string json =
+            R"({ "k\"1": "v\"1", "k2": { "k\"3": [ "v\"3", "v4" ], "k\"5": 5, "k6": 6 }, "k7": 7 })";
+        json_reader::scratch_t scratch;
+        json_reader nested;
+        nested.scratch = &scratch;
+        reader.scratch = &scratch;
+        size_t capacity = 0;
+        for (uint32_t pass = 0; pass < 3; ++pass) {
+            reader = json;
+            std::string keys;
+            reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                keys += key;
+                if (key == "k2") {
+                    reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                        keys += key;
+                        if (value.is_array()) {
+                            reader.parse([&](uint32_t, const json_reader::value_t& value) {
+                                keys += value.as_string();
+                            });
+                        }
+                    });
+                    nested = R"([ "n\"1" ])";
+                    nested.parse([&](uint32_t, const json_reader::value_t& value) {
+                        assert(value.as_string() == "n\"1");
+                    });
+                }
+                assert(key.size() == (key[1] == '"' ? 3 : 2));
+            });
+            assert(reader.error == nullptr);
+            assert(keys == "k\"1k2k\"3v\"3v4k\"5k6k7");
+            if (pass == 0) {
+                capacity = scratch.capacity();
+            }
+            assert(scratch.capacity() == capacity);
+        }
+        reader.scratch = nullptr;
+    }
+    {
+        // Escape decoding
+        reader =
+            R"({ "key\n": [ "\"\\\/\b\f\n\r\t", "\u0041\u00e9\u20AC\uD83D\uDE00",)"
+            R"(  "\uD800x\uDC00\uD83D", "\x", "plain" ] })";
+        reader.parse([&reader](json_reader::key_t key, const json_reader::value_t& value) {
+            assert(key == "key\n");
+            reader.parse([](uint32_t index, const json_reader::value_t& value) {
+                const char* expected[] = {
+                    "\"\\/\b\f\n\r\t",
+                    "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80",
+                    "\xEF\xBF\xBDx\xEF\xBF\xBD\xEF\xBF\xBD",
+                    "x",
+                    "plain"
+                };
+                assert(value.as_string() == expected[index]);
+            });
+        });
+        assert(reader.error == nullptr);
 
-    // =========================================================================
-    //      _ ____   ___  _   _    __              __  __           _                    ____            
-    //     | / ___| / _ \| \ | |  / _| ___  _ __  |  \/  | ___   __| | ___ _ __ _ __    / ___| _     _   
-    //  _  | \___ \| | | |  \| | | |_ / _ \| '__| | |\/| |/ _ \ / _` |/ _ \ '__| '_ \  | |   _| |_ _| |_ 
-    // | |_| |___) | |_| | |\  | |  _| (_) | |    | |  | | (_) | (_| |  __/ |  | | | | | |__|_   _|_   _|
-    //  \___/|____/ \___/|_| \_| |_|  \___/|_|    |_|  |_|\___/ \__,_|\___|_|  |_| |_|  \____||_|   |_|  
+        writer.array([](json_writer::array_t json) {
+            json.value("\x01\b\t\n\v\f\r\"\\");
+        });
+        reader = writer.buffer;
+        reader.parse([](uint32_t, const json_reader::value_t& value) {
+            assert(value.as_string() == "\x01\b\t\n\v\f\r\"\\");
+        });
+        assert(reader.error == nullptr);
 
-    bench.add("nlohmann_json", 0, [&](uint32_t) -> uint32_t {
-        uint32_t chsum = 0;
-        nlohmann::json json = nlohmann::json::parse(addressbookJson.begin(), addressbookJson.end());
-        if (!json.is_array()) {
-            return chsum;
-        }
-        for (const auto& it : json) {
-            if (!it.is_object()) {
-                continue;
+        reader = R"([ "\u12G4" ])";
+        reader.parse([](uint32_t, const json_reader::value_t&) {});
+        assert(reader.error != nullptr);
+        reader = R"([ "\u12)";
+        reader.parse([](uint32_t, const json_reader::value_t&) {});
+        assert(reader.error != nullptr);
+    }
+    {
+        // In-place unescaping
+        std::string buffer = R"({ "k\"1": [ "v\n1", "\u00e9\uD83D\uDE00 x" ], "k2": "v\\2" })";
+        json_reader::scratch_t scratch;
+        reader.scratch = &scratch;
+        reader.assign_mutable(&buffer[0], buffer.size());
+        std::vector<std::string_view> strings;
+        reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            strings.push_back(key);
+            if (value.is_array()) {
+                reader.parse([&](uint32_t, const json_reader::value_t& value) {
+                    strings.push_back(value.as_string());
+                });
             }
-            const auto itName = it.find("name");
-            if (itName != it.end() && itName->is_string()) {
-                chsum += itName->get<std::string_view>().size();
+            else {
+                strings.push_back(value.as_string());
             }
-            const auto itId = it.find("id");
-            if (itId != it.end() && itId->is_number()) {
-                chsum += itId->get<double>();
+        });
+        assert(reader.error == nullptr);
+        assert(scratch.capacity() == 0);
+        const char* expected[] = { "k\"1", "v\n1", "\xC3\xA9\xF0\x9F\x98\x80 x", "k2", "v\\2" };
+        assert(strings.size() == 5);
+        for (uint32_t i = 0; i < strings.size(); ++i) {
+            assert(strings[i] == expected[i]);
+            assert(strings[i].data() > buffer.data());
+            assert(strings[i].data() < buffer.data() + buffer.size());
+        }
+        reader.scratch = nullptr;
+    }
+    {
+        // Push parsing of chunks
+        const std::string json =
+            R"({ "id": 12345678, "name": "a\"b\u00e9", "tags": [ "x", "y" ],)"
+            R"(  "skip": { "a": [ "]" ] }, "ok": true, "pi": 3.14159 })";
+        for (size_t chunkSize = 1; chunkSize <= json.size(); ++chunkSize) {
+            json_push_reader push;
+            std::string log;
+            push.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                log += std::string(key) + ';';
+                switch_str(key, "id", "name", "tags", "ok", "pi") {
+                case_str("id"):
+                    assert(value.as_int64() == 12345678);
+                    break;
+                case_str("name"):
+                    assert(value.as_string() == "a\"b\xC3\xA9");
+                    break;
+                case_str("tags"):
+                    push.parse([&](uint32_t index, const json_reader::value_t& value) {
+                        log += value.as_string();
+                    });
+                    break;
+                case_str("ok"):
+                    assert(value.as_boolean());
+                    break;
+                case_str("pi"):
+                    assert(value.as_number() == 3.14159);
+                    break;
+                default:
+                    break;
+                }
+            });
+            for (size_t i = 0; i < json.size(); i += chunkSize) {
+                const std::string chunk = json.substr(i, chunkSize); // freed after push
+                push.push(chunk);
             }
-            const auto itEmail = it.find("email");
-            if (itEmail != it.end() && itEmail->is_string()) {
-                chsum += itEmail->get<std::string_view>().size();
+            push.finish();
+            assert(push.error == nullptr);
+            assert(log == "id;name;tags;xyskip;ok;pi;");
+        }
+
+        json_push_reader push;
+        {
+            const std::string chunk = R"({ "a": [ 1, 2 )"; // freed before finish()
+            push.push(chunk);
+        }
+        push.finish();
+        assert(push.error != nullptr && push.errorOffset == 14);
+
+        push.reset();
+        push.push(R"({ "a": )");
+        push.push(R"(1, 2 })");
+        assert(push.error != nullptr && push.errorOffset == 10);
+    }
+    {
+        // Memory-mapped file
+        const char* path = "cjwd_tests_file.json";
+        std::ofstream(path, std::ios::binary) << R"({ "name": "mapped", "list": [ 1, 2, 3 ] })";
+        {
+            json_file file(path);
+            assert(file.is_open());
+            reader = file.view();
+            std::string_view name;
+            uint32_t count = 0;
+            reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if (key == "name") {
+                    name = value.as_string();
+                }
+                else if (key == "list") {
+                    reader.parse([&](uint32_t, const json_reader::value_t&) {
+                        ++count;
+                    });
+                }
+            });
+            assert(reader.error == nullptr);
+            assert(name == "mapped" && count == 3); // valid while the file is open
+        }
+        std::ofstream(path, std::ios::binary).flush();
+        {
+            json_file file(path);
+            assert(file.is_open() && file.view().empty());
+        }
+        std::remove(path);
+        json_file file;
+        assert(!file.open(path));
+        assert(!file.is_open());
+    }
+    {
+        // Sequence of documents
+        reader =
+            "{ \"id\": 1 }\n"
+            "[ 2 ]\n"
+            "\n"
+            "{ \"id\": 3, \"bad\": tru }, \"rest\": [ 4 ] }\n"
+            "{ \"skipped\": { \"id\": 5 } }\n"
+            "{ \"id\": 6 }{ \"id\": 7 }";
+        std::string log;
+        uint32_t errors = 0;
+        uint32_t document = 0;
+        do {
+            ++document;
+            if (document == 4) {
+                continue; // not parsed
             }
-            const auto itPhones = it.find("phones");
-            if (itPhones != it.end() && itPhones->is_array()) {
-                for (const auto& itPhone : itPhones.value()) {
-                    if (!itPhone.is_object()) {
-                        continue;
-                    }
-                    const auto itNumber = itPhone.find("number");
-                    if (itNumber != itPhone.end() && itNumber->is_string()) {
-                        chsum += itNumber->get<std::string_view>().size();
-                    }
-                    const auto itType = itPhone.find("type");
-                    if (itType != itPhone.end() && itType->is_string()) {
-                        chsum += itType->get<std::string_view>().size();
+            if (reader.is_object()) {
+                reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                    if (key == "id") {
+                        log += std::to_string(value.as_int64());
                     }
-                }
+                });
             }
-            const auto itEmployment = it.find("employment");
-            if (itEmployment != it.end() && itEmployment->is_object()) {
-                const auto itVariant = itEmployment->find("variant");
-                if (itVariant != itEmployment->end() && itVariant->is_string()) {
-                    chsum += itVariant->get<std::string_view>().size();
+            else {
+                reader.parse([&](uint32_t, const json_reader::value_t& value) {
+                    log += std::to_string(value.as_int64());
+                });
+            }
+            errors += reader.error != nullptr;
+        } while (reader.next_document());
+        assert(document == 6);
+        assert(log == "12367");
+        assert(errors == 1);
+        assert(reader.error == nullptr);
+    }
+    {
+        // JSON Lines on several threads
+        std::string lines;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            lines += "{ \"id\": " + std::to_string(i) + " }\n";
+            if (i % 100 == 0) {
+                lines += "\n  // comment\r\n";
+            }
+        }
+        lines += "{ \"id\": bad }";
+        json_parallel_reader parallel;
+        parallel.threads = 4;
+        parallel.chunkSize = 64;
+
+        std::vector<int64_t> ids(1001, -1);
+        std::atomic<uint32_t> errors(0);
+        parallel.parse_lines(lines, [&](uint64_t ordinal, json_reader& reader) {
+            reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if (key == "id") {
+                    ids[ordinal] = value.as_int64();
                 }
-                const auto itText = itEmployment->find("text");
-                if (itText != itEmployment->end() && itText->is_string()) {
-                    chsum += itText->get<std::string_view>().size();
+            });
+            errors += reader.error != nullptr;
+        });
+        for (uint32_t i = 0; i < 1000; ++i) {
+            assert(ids[i] == i);
+        }
+        assert(errors == 1);
+
+        uint64_t expected = 0;
+        parallel.parse_lines_ordered(lines, [](uint64_t, json_reader& reader) {
+            int64_t id = -1;
+            reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if (key == "id") {
+                    id = value.as_int64();
                 }
+            });
+            return reader.error != nullptr ? -1 : id;
+        }, [&](uint64_t ordinal, int64_t id) {
+            assert(ordinal == expected++);
+            assert(id == (ordinal < 1000 ? static_cast<int64_t>(ordinal) : -1));
+        });
+        assert(expected == 1001);
+
+        std::atomic<uint32_t> records(0);
+        parallel.parse_lines(lines, [&](uint64_t ordinal, json_reader& reader) {
+            ++records;
+            if (ordinal == 5) {
+                reader.stop();
             }
-        }
-        return chsum;
-    });
+        });
+        assert(parallel.is_stopped() && records < 1001);
 
-    // =========================================================================
+        parallel.parse_lines("", [](uint64_t, json_reader&) {
+            assert(false);
+        });
+    }
+    {
+        // Root array on several threads
+        std::string array = "[\n";
+        for (uint32_t i = 0; i < 1000; ++i) {
+            array += "  { \"id\": " + std::to_string(i) + ", \"tags\": [ \"a,]\", \"\\\"}\" ], \"n\": { \"x\": [ 1, 2 ] } }";
+            array += i % 100 == 0 ? ", // comment, ]\n" : ",\n";
+            array += "  " + std::to_string(i) + ",\n";
+        }
+        array += "  \"last\"\n]";
+        json_parallel_reader parallel;
+        parallel.threads = 4;
+        parallel.chunkSize = 100;
 
-    nlohmann::json json_nl;
-    bench.add("nlohmann_json", 1, [&](uint32_t) -> uint32_t {
-        json_nl.clear();
-        for (const auto& person : addressbookData) {
-            nlohmann::json personObj;
-            personObj["name"] = person.name;
-            personObj["id"] = person.id;
-            personObj["email"] = person.email;
-            auto& phones = personObj["phones"];
-            for (const auto& phone : person.phones) {
-                nlohmann::json phoneObj;
-                phoneObj["number"] = phone.number;
-                phoneObj["type"] = phone.type;
-                phones.push_back(std::move(phoneObj));
+        std::vector<int64_t> ids(2001, -1);
+        parallel.parse_array(array, [&](uint32_t index, const json_reader::value_t& value, json_reader& reader) {
+            if (value.is_number()) {
+                ids[index] = value.as_int64();
             }
-            personObj["employment"]["variant"] = person.employment.variant;
-            if (!person.employment.text.empty()) {
-                personObj["employment"]["text"] = person.employment.text;
+            else if (value.is_object()) {
+                reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                    if (key == "id") {
+                        ids[index] = value.as_int64();
+                    }
+                });
             }
-            json_nl.push_back(std::move(personObj));
+            else {
+                assert(index == 2000 && value.as_string() == "last");
+                ids[index] = 0;
+            }
+        });
+        assert(parallel.error == nullptr);
+        for (uint32_t i = 0; i < 2000; ++i) {
+            assert(ids[i] == i / 2);
         }
-        return json_nl.dump(2).size();
-    });
+        assert(ids[2000] == 0);
 
-    // =========================================================================
-    //  ____             _     _     _ ____   ___  _   _ 
-    // |  _ \ __ _ _ __ (_) __| |   | / ___| / _ \| \ | |
-    // | |_) / _` | '_ \| |/ _` |_  | \___ \| | | |  \| |
-    // |  _ < (_| | |_) | | (_| | |_| |___) | |_| | |\  |
-    // |_| \_\__,_| .__/|_|\__,_|\___/|____/ \___/|_| \_|
-    //            |_|                                    
+        // stop() ends the whole parse, not only the batch of its worker
+        for (const uint32_t threads : { 1u, 4u }) {
+            parallel.threads = threads;
+            std::atomic<uint32_t> count(0);
+            parallel.parse_array(array, [&](uint32_t index, const json_reader::value_t&, json_reader& reader) {
+                ++count;
+                if (index == 10) {
+                    reader.stop();
+                }
+            });
+            assert(parallel.error == nullptr && parallel.is_stopped());
+            assert(count < 2001);
+            if (threads == 1) {
+                assert(count == 11);
+            }
+        }
+        std::atomic<uint32_t> count(0);
+        parallel.parse_array(array, [&](uint32_t, const json_reader::value_t&, json_reader&) {
+            ++count;
+        });
+        assert(parallel.error == nullptr && !parallel.is_stopped() && count == 2001);
+        parallel.threads = 4;
 
-    bench.add("rapidjson", 0, [&](uint32_t) -> uint32_t {
-        uint32_t chsum = 0;
+        parallel.parse_array("[ 1, 2, tru, 4 ]", [](uint32_t, const json_reader::value_t&, json_reader&) {});
+        assert(parallel.error != nullptr && *parallel.error == 't');
+        parallel.parse_array("{ \"a\": 1 }", [](uint32_t, const json_reader::value_t&, json_reader&) {
+            assert(false);
+        });
+        assert(parallel.error != nullptr && *parallel.error == '{');
+    }
+    {
+        // Structural index
+        std::string json = "{\n";
+        for (uint32_t i = 0; i < 20; ++i) {
+            json += "  \"item" + std::to_string(i) + "\": { \"id\": " + std::to_string(i)
+                + ", \"name\": \"a\\\"{[\\u00e9\", \"skip\": [ \"]\", { \"x\": \"}\" } ],"
+                + " \"list\": [ 1.5, -2, true, null ] },\n";
+        }
+        json += "  \"last\": false\n}";
+        const auto read = [&](const bool structuralIndex, std::string& log) {
+            reader.structuralIndex = structuralIndex;
+            reader = json;
+            reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                log += std::string(key) + ';';
+                if (!value.is_object()) {
+                    return;
+                }
+                reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                    if (key == "skip") {
+                        reader.skip();
+                    }
+                    else if (key == "list") {
+                        reader.parse([&](uint32_t index, const json_reader::value_t& value) {
+                            log += std::to_string(index) + (value.is_number() ? std::to_string(value.as_number()) : "");
+                        });
+                    }
+                    else if (key == "name") {
+                        log += std::string(value.as_string());
+                    }
+                    else {
+                        log += std::to_string(value.as_int64());
+                    }
+                });
+            });
+            return reader.error;
+        };
+        std::string expected;
+        std::string actual;
+        assert(read(false, expected) == nullptr);
+        assert(read(true, actual) == nullptr);
+        assert(actual == expected);
+
+        json.insert(json.size() - 1, "// a comment uses the normal mode\n");
+        actual.clear();
+        assert(read(true, actual) == nullptr);
+        assert(actual == expected);
+
+        reader = R"([ 1, 2, tru, 4 ])";
+        uint32_t count = 0;
+        reader.parse([&](uint32_t, const json_reader::value_t&) {
+            ++count;
+        });
+        assert(count == 2 && reader.error != nullptr && *reader.error == 't');
+
+        // A number or literal ends at whitespace or a structural character in both
+        // modes, a backslash outside strings is not an escape
+        for (const std::string_view input : { "[1null]", "[true1]", "[nullfalse]", "[1 null]", "[true\"a\"1]",
+                R"({ "a": 1"b": false"c": 2 })", R"({ "a": 1x })", "[-1+2]", R"([ [ 1, \"] ], 2 ], 3 ])" }) {
+            std::string logs[2];
+            const char* errors[2] = {};
+            for (const bool isIndex : { false, true }) {
+                reader.structuralIndex = isIndex;
+                reader = input;
+                std::string& log = logs[isIndex];
+                if (input[0] == '{') {
+                    reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                        log += std::string(key) + ';';
+                    });
+                }
+                else {
+                    reader.parse([&](uint32_t index, const json_reader::value_t& value) {
+                        log += std::to_string(index) + ';';
+                    });
+                }
+                errors[isIndex] = reader.error;
+            }
+            assert(logs[0] == logs[1] && errors[0] == errors[1]);
+        }
+        reader.structuralIndex = false;
+        reader = "[1null]";
+        reader.parse([&](uint32_t, const json_reader::value_t&) {});
+        assert(reader.error != nullptr && *reader.error == 'n');
+        reader = "[true1]";
+        reader.parse([&](uint32_t, const json_reader::value_t&) {});
+        assert(reader.error != nullptr && *reader.error == '1');
+        reader = "[1 null,true\"a\"]";
+        reader.parse([&](uint32_t, const json_reader::value_t&) {});
+        assert(reader.error == nullptr);
+    }
+    {
+        // Key sets
+        static constexpr json_keys<4> keys("name", "id", "", "tags");
+        static_assert(keys.size() == 4, "");
+        assert(keys.find("name") == 0 && keys.find("id") == 1 && keys.find("") == 2 && keys.find("tags") == 3);
+        assert(keys.find("nam") == keys.npos && keys.find("nane") == keys.npos && keys.find("t") == keys.npos);
+
+        reader = R"({ "id": 7, "skipped": { "id": 8, "tags": [ "}" ] }, "name": "aé", "": null,)"
+            R"( "tags": [ "x", "y" ], "x": [ { "name": 9 } ], "id": 10 })";
+        std::string log;
+        reader.parse(keys, [&](uint32_t key, const json_reader::value_t& value) {
+            switch (key) {
+            case 0:
+                log += std::string(value.as_string()) + ';';
+                break;
+            case 1:
+                log += std::to_string(value.as_int64()) + ';';
+                break;
+            case 2:
+                log += value.is_null() ? "null;" : "";
+                break;
+            case 3:
+                reader.parse([&](uint32_t, const json_reader::value_t& value) {
+                    log += value.as_string();
+                });
+                log += ';';
+                break;
+            default:
+                assert(false);
+            }
+        });
+        assert(reader.error == nullptr);
+        assert(log == "7;a\xC3\xA9;null;xy;10;");
+
+        // Keys that collide in length, first and last bytes
+        static constexpr json_keys<3> similar("abc", "axc", "ayc");
+        assert(similar.find("abc") == 0 && similar.find("axc") == 1 && similar.find("ayc") == 2);
+        assert(similar.find("azc") == similar.npos);
+        static constexpr json_keys<10> many("abAc", "abBc", "abCc", "abDc", "abEc",
+            "abFc", "abGc", "abHc", "abXc", "abYc");
+        static_assert(many.find("abXc") == 8 && many.find("abYc") == 9, "");
+        static_assert(many.find("abZc") == many.npos, "");
+        for (uint32_t i = 0; i < many.size(); ++i) {
+            assert(many.find(many[i]) == i);
+        }
+#if defined(CJWD_STRING_TEMPLATE_ARGS)
+        reader = R"({ "b": 2, "c": { "a": 0 }, "a": 1 })";
+        log.clear();
+        reader.parse<"a", "b">([&](uint32_t key, const json_reader::value_t& value) {
+            log += std::to_string(key) + '=' + std::to_string(value.as_int64()) + ';';
+        });
+        assert(reader.error == nullptr);
+        assert(log == "1=2;0=1;");
+#endif
+    }
+    {
+        // Paths
+        const json_paths paths = {
+            "/0/phones/1/number",
+            "/*/id",
+            "/1/a~1b",
+            "/*/phones/*/type",
+            "/1/employment",
+            "bad",
+            "/1/employment/text",
+        };
+        assert(paths.size() == 7 && !paths.is_valid());
+        reader =
+            R"([ { "id": 1, "phones": [ { "number": "a", "type": "x" }, { "type": "y", "number": "b" } ] },)"
+            R"(  { "a/b": true, "phones": [ { "type": "z" } ], "skip": { "id": 0 }, "id": 2,)"
+            R"(    "employment": { "text": "t", "id": 0 } },)"
+            R"(  "ignored", { "id": 3, "phones": {} } ])";
+        std::string log;
+        reader.parse(paths, [&](uint32_t path, const json_reader::value_t& value) {
+            log += std::to_string(path) + '=';
+            if (value.is_string()) {
+                log += std::string(value.as_string());
+            }
+            else if (value.is_number()) {
+                log += std::to_string(value.as_int64());
+            }
+            else if (value.is_boolean()) {
+                log += value.as_boolean() ? "true" : "false";
+            }
+            else {
+                log += value.is_object() ? "{}" : "[]";
+            }
+            log += ';';
+        });
+        assert(reader.error == nullptr);
+        assert(log == "1=1;3=x;3=y;0=b;2=true;3=z;1=2;4={};6=t;1=3;");
+
+        // The handler parses a matched object itself
+        reader = R"({ "a": { "b": 1 }, "c": { "b": 2 } })";
+        log.clear();
+        bool isFirst = true;
+        reader.parse(json_paths{ "/*", "/*/b" }, [&](uint32_t path, const json_reader::value_t& value) {
+            if (path == 1) {
+                log += std::to_string(value.as_int64());
+            }
+            else if (isFirst) {
+                isFirst = false;
+                reader.skip();
+            }
+        });
+        assert(reader.error == nullptr);
+        assert(log == "2");
+
+        uint32_t count = 0;
+        reader = R"({ "a": [ 1, tru ] })";
+        reader.parse(json_paths{ "", "/a/0" }, [&](uint32_t, const json_reader::value_t&) {
+            ++count;
+        });
+        assert(count == 2 && reader.error != nullptr && *reader.error == 't');
+    }
+    {
+        // Pull cursor
+        json_cursor cursor;
+        cursor =
+            R"({ "id": -12, "name": "a\"bé", // comment)""\n"
+            R"(  "skip": { "a": [ "}" ] }, "unread": [ 1 ], "list": [ 1.5, true, null, { "x": 1 }, [] ],)"
+            R"(  "stop": [ 1, 2, 3 ], "last": false })";
+        json_reader::key_t key;
+        json_reader::value_t value;
+        assert(cursor.next_value(value) && value.is_object());
+        assert(cursor.enter() && cursor.is_object() && cursor.depth() == 1);
+        std::string log;
+        while (cursor.next_key(key)) {
+            log += std::string(key) + ':';
+            if (key == "unread") {
+                continue;
+            }
+            assert(cursor.next_value(value));
+            if (key == "id") {
+                log += std::to_string(value.as_int64());
+            }
+            else if (key == "name") {
+                log += std::string(value.as_string());
+            }
+            else if (key == "skip") {
+                cursor.skip();
+            }
+            else if (key == "list") {
+                assert(cursor.enter() && cursor.is_array());
+                while (cursor.next_value(value)) {
+                    log += value.is_number() ? std::to_string(value.as_number())
+                        : value.is_boolean() ? "true"
+                        : value.is_null() ? "null"
+                        : value.is_object() ? "{}" : "[]";
+                    log += ',';
+                }
+                assert(cursor.depth() == 1);
+            }
+            else if (key == "stop") {
+                assert(cursor.enter() && cursor.next_value(value) && value.as_int64() == 1);
+                cursor.skip(); // the rest of the array
+                assert(cursor.depth() == 1 && cursor.is_object());
+            }
+            else if (key == "last") {
+                log += value.as_boolean() ? "true" : "false";
+            }
+            log += ';';
+        }
+        assert(cursor.error == nullptr && cursor.depth() == 0);
+        assert(log == "id:-12;name:a\"b\xC3\xA9;skip:;unread:list:1.500000,true,null,{},[],;stop:;last:false;");
+        assert(!cursor.next_value(value) && cursor.error == nullptr);
+
+        json_cursor copy;
+        copy = "[ 1, 2, [ 3, tru ] ]";
+        assert(copy.next_value(value) && copy.enter() && copy.next_value(value));
+        cursor = copy; // the state is copyable
+        assert(cursor.next_value(value) && value.as_int64() == 2);
+        assert(cursor.next_value(value) && cursor.enter() && cursor.next_value(value) && value.as_int64() == 3);
+        assert(!cursor.next_value(value) && cursor.error != nullptr && *cursor.error == 't');
+        assert(copy.next_value(value) && value.as_int64() == 2 && copy.error == nullptr);
+
+        cursor = "{ \"a\": 1 ";
+        assert(cursor.next_value(value) && cursor.enter() && cursor.next_key(key) && cursor.next_value(value));
+        assert(!cursor.next_key(key) && cursor.error != nullptr);
+        cursor = "";
+        assert(!cursor.next_value(value) && cursor.error != nullptr);
+
+        // A shared arena keeps the strings decoded before the cursor
+        json_reader::scratch_t shared;
+        json_cursor first;
+        first.scratch = &shared;
+        first = R"([ "a\tb" ])";
+        assert(first.next_value(value) && first.enter() && first.next_value(value));
+        const std::string_view held = value.as_string();
+        json_cursor second;
+        second.scratch = &shared;
+        second = R"({ "k\n": "x\ny", "k2": "z\tzzz" })";
+        assert(second.next_value(value) && second.enter());
+        while (second.next_key(key) && second.next_value(value)) {}
+        assert(second.error == nullptr && held == "a\tb");
+    }
+#if defined(CJWD_COROUTINES)
+    {
+        // Coroutine events
+        const std::string_view input = R"({ "a": [ 1, "s\n", { "b": null } ], "c": {}, "d": true })";
+        const auto logEvent = [](std::string& log, const json_event& event) {
+            switch (event.type) {
+            case json_event::types::begin_object:
+                log += std::string(event.key) + '{';
+                break;
+            case json_event::types::end_object:
+                log += '}';
+                break;
+            case json_event::types::begin_array:
+                log += std::string(event.key) + '[';
+                break;
+            case json_event::types::end_array:
+                log += ']';
+                break;
+            case json_event::types::key:
+                log += std::string(event.key) + ':';
+                break;
+            case json_event::types::value:
+                log += event.value.is_number() ? std::to_string(event.value.as_int64())
+                    : event.value.is_string() ? std::string(event.value.as_string())
+                    : event.value.is_null() ? "null"
+                    : event.value.as_boolean() ? "true" : "false";
+                log += ',';
+                break;
+            }
+        };
+        std::string log;
+        json_event_generator events = json_events(input);
+        for (const json_event& event : events) {
+            logEvent(log, event);
+        }
+        assert(events.error() == nullptr);
+        assert(log == "{a:a[1,s\n,{b:null,}]c:c{}d:true,}");
+
+        uint32_t count = 0;
+        events = json_events("[ 1, [ 2, tru ] ]");
+        while (events.next()) {
+            ++count;
+        }
+        assert(count == 4 && events.error() != nullptr && *events.error() == 't');
+
+        events = json_events("12");
+        assert(events.next() && events.event().value.as_int64() == 12 && !events.next());
+        assert(events.error() == nullptr);
+
+        // Frames are reused
+        const json_event* first = nullptr;
+        for (uint32_t i = 0; i < 4; ++i) {
+            json_event_generator generator = json_events("[ 1 ]");
+            assert(generator.next());
+            if (first == nullptr) {
+                first = &generator.event();
+            }
+            assert(first == &generator.event());
+        }
+
+        // Pushed chunks, the document is split at every byte
+        const std::string_view pushedInput =
+            R"({ "k\"ey": [ 12345, -1.5, "s\té", { "b": null, "t": true } ], "c": {}, "d": false, "e": 678 })";
+        std::string expected;
+        for (const json_event& event : json_events(pushedInput)) {
+            logEvent(expected, event);
+        }
+        for (size_t split = 0; split <= pushedInput.size(); ++split) {
+            json_event_input chunks;
+            json_event_generator pushedEvents = json_events(chunks);
+            std::string pushedLog;
+            chunks.push(pushedInput.substr(0, split));
+            for (const json_event& event : pushedEvents) {
+                logEvent(pushedLog, event);
+            }
+            chunks.push(pushedInput.substr(split));
+            for (const json_event& event : pushedEvents) {
+                logEvent(pushedLog, event);
+            }
+            assert(pushedEvents.error() == nullptr);
+            chunks.finish();
+            for (const json_event& event : pushedEvents) {
+                logEvent(pushedLog, event);
+            }
+            assert(pushedEvents.error() == nullptr && pushedLog == expected);
+        }
+
+        // Byte by byte, the error has its offset in the document
+        json_event_input bytes;
+        events = json_events(bytes);
+        log.clear();
+        const std::string_view broken = R"([ 1, { "a": tru } ])";
+        for (const char c : broken) {
+            bytes.push(std::string_view(&c, 1));
+            while (events.next()) {
+                logEvent(log, events.event());
+            }
+        }
+        assert(events.error() != nullptr && bytes.errorOffset == 12 && log == "[1,{a:");
+    }
+#endif
+    {
+        // Stopping from handlers
+        reader = R"({ "type": "event", "data": { "list": [ 1, { "x": 2 } ], "y": 3 }, "z": 4 })";
+        std::string log;
+        reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            log += std::string(key) + ';';
+            if (key == "data") {
+                reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                    log += std::string(key) + ';';
+                    reader.parse([&](uint32_t index, const json_reader::value_t& value) {
+                        log += std::to_string(index) + ';';
+                        if (value.is_object()) {
+                            reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                                log += std::string(key) + ';';
+                                reader.stop();
+                            });
+                            log += "after;";
+                        }
+                    });
+                });
+            }
+        });
+        assert(log == "type;data;list;0;1;x;after;");
+        assert(reader.error == nullptr && reader.is_stopped() && *reader.begin == '2');
+
+        // The same for the structural index, std::function and skipping
+        for (const bool isIndex : { false, true }) {
+            reader.structuralIndex = isIndex;
+            reader = R"([ "a", { "b": [ 1 ] }, "c", broken ])";
+            uint32_t count = 0;
+            reader.parse(std::function<void(uint32_t, const json_reader::value_t&)>(
+                    [&](uint32_t index, const json_reader::value_t& value) {
+                ++count;
+                if (index == 1) {
+                    reader.stop();
+                    reader.skip(); // no effect after stop()
+                }
+            }));
+            assert(count == 2 && reader.error == nullptr && reader.is_stopped());
+        }
+        reader.structuralIndex = false;
+
+        // The rest of a stopped document is skipped by next_document()
+        reader = "{ \"a\": [ 1, 2 ], \"b\": 3 }\n{ \"a\": [ 4 ] }";
+        uint32_t sum = 0;
+        do {
+            assert(!reader.is_stopped());
+            reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                reader.parse([&](uint32_t index, const json_reader::value_t& value) {
+                    sum += value.as_int64();
+                    reader.stop();
+                });
+            });
+            assert(reader.error == nullptr && reader.is_stopped());
+        } while (reader.next_document());
+        assert(sum == 1 + 4 && reader.error == nullptr);
+    }
+    {
+        // Reader policies
+        json_strict_reader strict;
+        strict = R"({ "a": [ 1, -2.5e1, "s" ], "b": null })";
+        uint32_t count = 0;
+        strict.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            ++count;
+        });
+        assert(count == 2 && strict.error == nullptr);
+        for (const char* input : { "{ \"a\": 1, // comment\n \"b\": 2 }", "[ 1, +2 ]", "{ \"a\": [ +1 ] }" }) {
+            for (const bool isIndex : { false, true }) {
+                strict.structuralIndex = isIndex;
+                strict = input;
+                if (strict.is_object()) {
+                    strict.parse([&](json_reader::key_t, const json_reader::value_t& value) {
+                        strict.parse([&](uint32_t, const json_reader::value_t&) {});
+                    });
+                }
+                else {
+                    strict.parse([&](uint32_t, const json_reader::value_t&) {});
+                }
+                assert(strict.error != nullptr && (*strict.error == '/' || *strict.error == '+'));
+            }
+        }
+        // Commas, numbers, escapes and control characters, also in skipped values
+        struct strict_input_t {
+            const char* input;
+            size_t errorOffset;
+        };
+        const strict_input_t strictInputs[] = {
+            { "[ 1 2 ]", 4 }, { R"({ "a": 1 "b": 2 })", 9 }, { "[ , 1 ]", 2 }, { "[ 1, , 2 ]", 5 },
+            { "[ 1, ]", 5 }, { R"({ "a": 1, })", 10 }, { "[ [ 1 ] [ 2 ] ]", 8 }, { "[ [ 1, ] ]", 7 },
+            { "[ 01 ]", 2 }, { "[ -01 ]", 2 }, { "[ 1. ]", 2 }, { "[ -.5 ]", 2 }, { "[ 1e ]", 2 },
+            { "[ 1.5e+ ]", 2 }, { R"([ "\q" ])", 3 }, { R"([ "\u12G4" ])", 3 }, { R"({ "k\q": 1 })", 4 },
+            { "[ \"a\tb\" ]", 4 }, { "[ [ \"a\nb\" ] ]", 6 }, { "x[ 1 ]", 0 }, { "[ 1 ] x", 6 },
+            { "[ 1 ]\n x", 7 }, { "[ 1 ] [ 2 ]", 6 }, { "{ \"a\": 1 }]", 10 },
+        };
+        for (const strict_input_t& strictInput : strictInputs) {
+            for (const bool isIndex : { false, true }) {
+                for (const bool isSkipped : { false, true }) {
+                    strict.structuralIndex = isIndex;
+                    strict = strictInput.input;
+                    const auto parseAll = [&](auto& parseAll, const json_reader::value_t& value,
+                            const uint32_t level) -> void {
+                        if (isSkipped && (level > 0)) {
+                            return;
+                        }
+                        if (value.is_object()) {
+                            strict.parse([&](json_reader::key_t, const json_reader::value_t& value) {
+                                parseAll(parseAll, value, level + 1);
+                            });
+                        }
+                        else if (value.is_array()) {
+                            strict.parse([&](uint32_t, const json_reader::value_t& value) {
+                                parseAll(parseAll, value, level + 1);
+                            });
+                        }
+                    };
+                    json_reader::value_t root;
+                    if (strict.is_object()) {
+                        root.emplace<json_reader::object_idx>();
+                    }
+                    else {
+                        root.emplace<json_reader::array_idx>();
+                    }
+                    parseAll(parseAll, root, 0);
+                    assert(strict.error == strictInput.input + strictInput.errorOffset);
+                }
+            }
+        }
+        // Only whitespace around the root, documents of a sequence on new lines
+        for (const bool isIndex : { false, true }) {
+            strict.structuralIndex = isIndex;
+            strict = " [ 1 ]\n{ \"a\": 2 } \r\n\n[ 3 ]\n";
+            uint32_t documents = 0;
+            do {
+                if (documents == 1) {
+                    strict.parse([&](json_reader::key_t, const json_reader::value_t&) {});
+                    assert(strict.error == nullptr);
+                }
+                ++documents;
+            } while (strict.next_document());
+            assert(documents == 3 && strict.error == nullptr);
+            const char* garbage = "[ 1 ]\n[ 2 ]\nx";
+            strict = garbage;
+            while (strict.next_document()) {
+            }
+            assert(strict.error == garbage + 12);
+        }
+        strict.structuralIndex = false;
+        strict = R"([ 0, -0, 0.5, -1.5e-3, 1E+5, "\"\\\/\b\f\n\r\té", [], {}, [ { "a": [ 1 ] } ] ])";
+        strict.parse([&](uint32_t, const json_reader::value_t&) {});
+        assert(strict.error == nullptr);
+        json_reader loose;
+        loose = "[ 1 2, , 01, 1. ]";
+        loose.parse([&](uint32_t, const json_reader::value_t&) {});
+        assert(loose.error == nullptr);
+
+        basic_json_reader<raw_policy> raw;
+        raw = R"({ "a\"b": "c\u0041" })";
+        raw.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            assert(key == R"(a\"b)" && value.as_string() == R"(c\u0041)");
+        });
+        assert(raw.error == nullptr);
+
+        basic_json_reader<unique_policy> unique;
+        for (const bool isIndex : { false, true }) {
+            unique.structuralIndex = isIndex;
+            unique = R"({ "a": { "a": 1, "b": 2 }, "b": [ { "a": 1 }, { "a": 2 } ], "\u0062": 3 })";
+            const auto parseAll = [&](auto& parseAll, const json_reader::value_t& value) -> void {
+                if (value.is_object()) {
+                    unique.parse([&](json_reader::key_t, const json_reader::value_t& value) {
+                        parseAll(parseAll, value);
+                    });
+                }
+                else if (value.is_array()) {
+                    unique.parse([&](uint32_t, const json_reader::value_t& value) {
+                        parseAll(parseAll, value);
+                    });
+                }
+            };
+            json_reader::value_t root;
+            root.emplace<json_reader::object_idx>();
+            parseAll(parseAll, root);
+            assert(unique.error != nullptr && std::string_view(unique.error, 8) == R"("\u0062")");
+
+            unique = R"({ "a": { "a": 1, "b": 2 }, "b": [ { "a": 1 }, { "a": 2 } ] })";
+            parseAll(parseAll, root);
+            assert(unique.error == nullptr);
+
+            // A repeated key written with an escape in a skipped object
+            unique = R"({ "o": { "a": 1, "\u0061": 2 }, "p": 3 })";
+            unique.parse([&](json_reader::key_t, const json_reader::value_t&) {});
+            assert(unique.error != nullptr && std::string_view(unique.error, 8) == R"("\u0061")");
+        }
+        // Many keys are checked in linear time
+        std::string many = "{";
+        for (uint32_t i = 0; i < 100000; ++i) {
+            many += (i == 0 ? "\"k" : ",\"k") + std::to_string(i) + "\":{\"a\":" + std::to_string(i) + "}";
+        }
+        const std::string repeated = many + ",\"k99999\":1}";
+        many += "}";
+        unique.structuralIndex = false;
+        unique = repeated;
+        const auto started = std::chrono::steady_clock::now();
+        unique.parse([&](json_reader::key_t, const json_reader::value_t&) {});
+        assert(unique.error != nullptr && std::string_view(unique.error, 8) == R"("k99999")");
+        assert(std::chrono::steady_clock::now() - started < std::chrono::seconds(1));
+        unique = many;
+        unique.parse([&](json_reader::key_t, const json_reader::value_t&) {});
+        assert(unique.error == nullptr);
+    }
+    {
+        // Skipping of unhandled subtrees
+        reader =
+            R"({)""\n"
+            R"(  "skip1": { "a": "}]\"{[", "b": [ 1, [ 2, { "c": "\\" } ] ] },)""\n"
+            R"(  "skip2": [ // comment with " and ] and }])""\n"
+            R"(    "long string with brackets {{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{{",)""\n"
+            R"(    { "escaped": "\\\\\\\"]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]" })""\n"
+            R"(  ],)""\n"
+            R"(  "skip3": { "explicit": [ "]" ] },)""\n"
+            R"(  "read": "ok")""\n"
+            R"(})";
+        assert(reader.is_object());
+        uint32_t count = 0;
+        reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            ++count;
+            if (key == "skip3") {
+                reader.skip();
+            }
+            else if (key == "read") {
+                assert(value.as_string() == "ok");
+            }
+            else {
+                assert(value.is_object() || value.is_array());
+            }
+        });
+        assert(count == 4);
+        assert(reader.error == nullptr);
+
+        reader = R"([ { "a": "\"" }, [ "]", 1 ], 2 ])";
+        assert(reader.is_array());
+        count = 0;
+        reader.parse([&](uint32_t index, const json_reader::value_t& value) {
+            count += index;
+            if (index == 1) {
+                reader.skip();
+            }
+        });
+        assert(count == 0 + 1 + 2);
+        assert(reader.error == nullptr);
+
+        reader = R"({ "a": [ "unterminated ] })";
+        reader.parse([](json_reader::key_t, const json_reader::value_t&) {});
+        assert(reader.error != nullptr);
+
+        // A string that ends in the block of the closing bracket
+        reader =
+            R"([ { "tags": [ "alpha", "beta", "gamma"  ]  },)"
+            R"(  { "name": "padding to the next 64-byte block of the skipper" } ])";
+        reader.parse([&reader](uint32_t, const json_reader::value_t&) {
+            reader.parse([](json_reader::key_t, const json_reader::value_t&) {});
+        });
+        assert(reader.error == nullptr);
+    }
+    {
+        // Exact 64-bit integers
+        reader =
+            R"([ 0, -0, 9007199254740993, -9223372036854775808, 9223372036854775807,)"
+            R"(  9223372036854775808, 18446744073709551615, 18446744073709551616,)"
+            R"(  -9223372036854775809, 1.5, 1e3, 12E-1, +7 ])";
+        assert(reader.is_array());
+        reader.parse([](uint32_t index, const json_reader::value_t& value) {
+            assert(value.is_number());
+            switch (index) {
+            case 0:
+            case 1:
+                assert(value.is_integer() && value.as_int64() == 0);
+                break;
+            case 2:
+                assert(value.is_integer() && value.as_int64() == 9007199254740993);
+                break;
+            case 3:
+                assert(value.is_integer() && value.as_int64() == INT64_MIN);
+                break;
+            case 4:
+                assert(value.is_integer() && value.as_int64() == INT64_MAX);
+                break;
+            case 5:
+                assert(value.is_integer() && value.as_uint64() == 9223372036854775808ull);
+                assert(value.index() == json_reader::uint64_idx);
+                break;
+            case 6:
+                assert(value.is_integer() && value.as_uint64() == UINT64_MAX);
+                break;
+            case 7:
+                assert(!value.is_integer() && value.as_number() == 18446744073709551616.0);
+                break;
+            case 8:
+                assert(!value.is_integer() && value.as_number() == -9223372036854775809.0);
+                break;
+            case 9:
+                assert(!value.is_integer() && value.as_number() == 1.5);
+                break;
+            case 10:
+                assert(!value.is_integer() && value.as_number() == 1000);
+                break;
+            case 11:
+                assert(!value.is_integer() && value.as_number() == 1.2);
+                break;
+            case 12:
+                assert(value.is_integer() && value.as_number() == 7);
+                break;
+            default:
+                assert(false);
+                break;
+            }
+        });
+        assert(reader.error == nullptr);
+
+        reader = R"({ "a": 12-3 })";
+        reader.parse([](json_reader::key_t, const json_reader::value_t&) {});
+        assert(reader.error != nullptr);
+
+        // Out of range conversions are clamped
+        for (const bool lazyNumbers : { false, true }) {
+            reader = R"([ 18446744073709551616, -1e30, -1.5, 9223372036854775808, -1, 2.9, -0 ])";
+            reader.lazyNumbers = lazyNumbers;
+            reader.parse([](uint32_t index, const json_reader::value_t& value) {
+                int64_t i = 0;
+                uint64_t u = 0;
+                const bool isInt = value.try_as_int64(i);
+                const bool isUint = value.try_as_uint64(u);
+                switch (index) {
+                case 0:
+                    assert(!isInt && i == INT64_MAX && !isUint && u == UINT64_MAX);
+                    break;
+                case 1:
+                    assert(!isInt && i == INT64_MIN && !isUint && u == 0);
+                    break;
+                case 2:
+                    assert(isInt && i == -1 && !isUint && u == 0);
+                    break;
+                case 3:
+                    assert(!isInt && i == INT64_MAX && isUint && u == 9223372036854775808ull);
+                    break;
+                case 4:
+                    assert(isInt && i == -1 && !isUint && value.as_uint64() == 0);
+                    break;
+                case 5:
+                    assert(isInt && i == 2 && isUint && u == 2);
+                    break;
+                case 6:
+                    assert(isInt && i == 0 && value.is_integer());
+                    break;
+                default:
+                    assert(false);
+                    break;
+                }
+            });
+            assert(reader.error == nullptr);
+        }
+        reader.lazyNumbers = false;
+        json_reader::value_t nan;
+        nan.emplace<json_reader::number_idx>(std::nan(""));
+        int64_t nanInt = 1;
+        assert(!nan.try_as_int64(nanInt) && nanInt == 0 && nan.as_uint64() == 0);
+
+        // Numbers that end right at the next token
+        double sum = 0.0;
+        reader = R"({"a":-1,"b":[2.5e1,3],"c":4})";
+        reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            if (key == "b") {
+                reader.parse([&](uint32_t, const json_reader::value_t& value) {
+                    sum += value.as_number();
+                });
+                return;
+            }
+            sum += value.as_number();
+        });
+        assert(reader.error == nullptr);
+        assert(sum == 31.0);
+
+        // The input ends in a number or before a closing bracket
+        for (const bool isIndex : { false, true }) {
+            reader.structuralIndex = isIndex;
+            for (const char* truncated : { "[ 1, 2", R"({ "a": 12)", R"({ "a": 1, "b": "x" )",
+                    R"([ { "a": [ 1 ] }, )", R"({ "a": [ 1, [ 2 ] )", "[ [ 1 ], [ 2" }) {
+                for (const bool isSkipped : { false, true }) {
+                    std::function<void(bool)> read = [&](const bool isObject) {
+                        const auto nested = [&](const json_reader::value_t& value) {
+                            if (!isSkipped && (value.is_object() || value.is_array())) {
+                                read(value.is_object());
+                            }
+                        };
+                        if (isObject) {
+                            reader.parse([&](json_reader::key_t, const json_reader::value_t& value) {
+                                nested(value);
+                            });
+                        }
+                        else {
+                            reader.parse([&](uint32_t, const json_reader::value_t& value) {
+                                nested(value);
+                            });
+                        }
+                    };
+                    reader = truncated;
+                    read(reader.is_object());
+                    assert(reader.error != nullptr);
+                }
+            }
+        }
+        reader.structuralIndex = false;
+    }
+    {
+        // Lazy numbers
+        reader = R"({ "a": 123456789012345678901234567890.5, "b": -12, "c": 1e-2, "d": [ 18446744073709551615 ] })";
+        reader.lazyNumbers = true;
+        reader.parse([&reader](json_reader::key_t key, const json_reader::value_t& value) {
+            assert(value.is_number() || key == "d");
+            switch_str(key, "a", "b", "c", "d") {
+            case_str("a"):
+                assert(value.as_raw_number() == "123456789012345678901234567890.5");
+                assert(!value.is_integer());
+                break;
+            case_str("b"):
+                assert(value.as_raw_number() == "-12");
+                assert(value.is_integer());
+                assert(value.as_int64() == -12);
+                assert(value.as_number() == -12.0);
+                break;
+            case_str("c"):
+                assert(value.as_number() == 1e-2);
+                assert(value.as_number() == 1e-2);
+                break;
+            case_str("d"):
+                reader.parse([](uint32_t index, const json_reader::value_t& value) {
+                    assert(value.as_raw_number() == "18446744073709551615");
+                    assert(value.as_uint64() == UINT64_MAX);
+                });
+                break;
+            default:
+                assert(false);
+                break;
+            }
+        });
+        assert(reader.error == nullptr);
+
+        // Malformed numbers are reported at the same byte also if lazy
+        for (const char* malformed : { "[ 1-2 ]", "[ --1 ]", "[ 1.2.3 ]", "[ - ]", "[ 1e ]",
+                R"({"a":1-2})", "[ + ]", "[ +-1.5 ]" }) {
+            const char* eagerError = nullptr;
+            for (const bool isIndex : { false, true }) {
+                for (const bool lazyNumbers : { false, true }) {
+                    reader.structuralIndex = isIndex;
+                    reader.lazyNumbers = lazyNumbers;
+                    reader = malformed;
+                    if (reader.is_object()) {
+                        reader.parse([](json_reader::key_t, const json_reader::value_t&) {});
+                    }
+                    else {
+                        reader.parse([](uint32_t, const json_reader::value_t&) {});
+                    }
+                    if (eagerError == nullptr) {
+                        eagerError = reader.error;
+                    }
+                    assert(reader.error != nullptr && reader.error == eagerError);
+
+                    json_cursor cursor;
+                    cursor.lazyNumbers = lazyNumbers;
+                    cursor = malformed;
+                    json_reader::key_t key;
+                    json_reader::value_t value;
+                    assert(cursor.next_value(value) && cursor.enter());
+                    while ((!cursor.is_object() || cursor.next_key(key)) && cursor.next_value(value)) {}
+                    assert(cursor.error == eagerError);
+                }
+            }
+        }
+        reader.structuralIndex = false;
+        reader.lazyNumbers = false;
+    }
+    {
+        // Correctly rounded floats
+        reader =
+            R"([ 0.1, -2.5e-3, 1.7976931348623157e308, 2.2250738585072011e-308, 4.9406564584124654e-324,)"
+            R"(  9007199254740993.0, 1.00000000000000011102230246251565404236316680908203125,)"
+            R"(  3.14159265358979323846264338327950288419716939937510582097494459, 1e400, 1e-400 ])";
+        reader.parse([](uint32_t index, const json_reader::value_t& value) {
+            const double expected[] = {
+                0.1, -2.5e-3, 1.7976931348623157e308, 2.2250738585072011e-308, 4.9406564584124654e-324,
+                9007199254740993.0, 1.00000000000000011102230246251565404236316680908203125,
+                3.14159265358979323846264338327950288419716939937510582097494459, HUGE_VAL, 0.0
+            };
+            assert(index < sizeof(expected) / sizeof(expected[0]));
+            assert(value.as_number() == expected[index]);
+        });
+        assert(reader.error == nullptr);
+
+        reader = R"({ "a": 1e })";
+        reader.parse([](json_reader::key_t, const json_reader::value_t&) {});
+        assert(reader.error != nullptr);
+    }
+    {
+        // Digit runs across 8-byte words
+        reader = R"([ 12345678, 1234567890123456789, 12345678.87654321, 0.000000001234567890123, 123456789012 ])";
+        reader.parse([](uint32_t index, const json_reader::value_t& value) {
+            const double expected[] = {
+                12345678, 1234567890123456789.0, 12345678.87654321, 0.000000001234567890123, 123456789012
+            };
+            assert(value.as_number() == expected[index]);
+            assert(value.is_integer() == (index != 2 && index != 3));
+        });
+        assert(reader.error == nullptr);
+
+        reader = R"({ "a": 123456789-12345678 })";
+        reader.parse([](json_reader::key_t, const json_reader::value_t&) {});
+        assert(reader.error != nullptr);
+    }
+    std::cout << "All the tests passed successfully." << std::endl;
+}
+
+// Removes whitespace outside of strings.
+std::string minify(const std::string_view json) {
+    std::string result;
+    bool isString = false;
+    bool isPrevEscape = false;
+    for (const char c : json) {
+        if (isString) {
+            if (isPrevEscape) {
+                isPrevEscape = false;
+            }
+            else if (c == '\\') {
+                isPrevEscape = true;
+            }
+            else if (c == '"') {
+                isString = false;
+            }
+        }
+        else if (c == '"') {
+            isString = true;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            continue;
+        }
+        result.push_back(c);
+    }
+    return result;
+}
+
+// Branches and branch mispredictions of the calling thread, from the hardware
+// counters. Only on Linux, and not in every VM or container.
+class branch_counters {
+public:
+    branch_counters() {
+#if defined(__linux__)
+        misses = open(PERF_COUNT_HW_BRANCH_MISSES);
+        branches = open(PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+#endif
+    }
+    ~branch_counters() {
+#if defined(__linux__)
+        if (misses >= 0) {
+            close(misses);
+        }
+        if (branches >= 0) {
+            close(branches);
+        }
+#endif
+    }
+    bool is_available() const {
+        return (misses >= 0) & (branches >= 0);
+    }
+    // Returns the branches and the mispredictions while `function` runs.
+    std::pair<uint64_t, uint64_t> measure(const std::function<void()>& function) {
+        std::pair<uint64_t, uint64_t> result(0, 0);
+#if defined(__linux__)
+        ioctl(misses, PERF_EVENT_IOC_RESET, 0);
+        ioctl(branches, PERF_EVENT_IOC_RESET, 0);
+        ioctl(misses, PERF_EVENT_IOC_ENABLE, 0);
+        ioctl(branches, PERF_EVENT_IOC_ENABLE, 0);
+        function();
+        ioctl(misses, PERF_EVENT_IOC_DISABLE, 0);
+        ioctl(branches, PERF_EVENT_IOC_DISABLE, 0);
+        if ((read(branches, &result.first, sizeof(uint64_t)) != sizeof(uint64_t))
+                | (read(misses, &result.second, sizeof(uint64_t)) != sizeof(uint64_t))) {
+            result = { 0, 0 };
+        }
+#else
+        function();
+#endif
+        return result;
+    }
+
+private:
+#if defined(__linux__)
+    static int32_t open(const uint64_t config) {
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int32_t>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+    int32_t misses = -1;
+    int32_t branches = -1;
+};
+
+void benchmark() {
+    constexpr std::string_view addressbookJson =
+        R"([)"
+        R"(    {)"
+        R"(        "name": "Alice",)"
+        R"(        "id": 123,)"
+        R"(        "email": "alice@example.com",)"
+        R"(        "phones": [)"
+        R"(            { "number": "555-1212", "type": "MOBILE" })"
+        R"(        ],)"
+        R"(        "ignore": { "ignore": null },)"
+        R"(        "employment": {)"
+        R"(            "variant": "school",)"
+        R"(            "text": "MIT")"
+        R"(        })"
+        R"(    },)"
+        R"(    {)"
+        R"(        "name": "Bob",)"
+        R"(        "id": 456,)"
+        R"(        "email": "bob@example.com",)"
+        R"(        "phones": [)"
+        R"(            { "number": "555-4567", "type": "HOME" },)"
+        R"(            { "number": "555-7654", "type": "WORK" })"
+        R"(        ],)"
+        R"(        "employment": {)"
+        R"(            "variant": "unemployed")"
+        R"(        })"
+        R"(    })"
+        R"(])";
+    struct Person {
+        std::string name;
+        uint32_t id;
+        std::string email;
+        struct Phone {
+            std::string number;
+            std::string type;
+        };
+        std::vector<Phone> phones;
+        struct Employment {
+            std::string variant;
+            std::string text;
+        };
+        Employment employment;
+    };
+    const std::initializer_list<Person> addressbookData = {
+        {
+            "Alice",
+            123,
+            "alice@example.com",
+            {
+                { "555-1212", "MOBILE" }
+            },
+            {
+                "school", "MIT"
+            }
+        },
+        {
+            "Bob",
+            456,
+            "bob@example.com",
+            {
+                { "555-4567", "HOME" },
+                { "555-7654", "WORK" }
+            },
+            {
+                "unemployed", std::string()
+            }
+        }
+    };
+
+    Benchmark bench;
+    bench.setColumnsNumber(2);
+
+    // =========================================================================
+    //      _ ____   ___  _   _    __              __  __           _                    ____            
+    //     | / ___| / _ \| \ | |  / _| ___  _ __  |  \/  | ___   __| | ___ _ __ _ __    / ___| _     _   
+    //  _  | \___ \| | | |  \| | | |_ / _ \| '__| | |\/| |/ _ \ / _` |/ _ \ '__| '_ \  | |   _| |_ _| |_ 
+    // | |_| |___) | |_| | |\  | |  _| (_) | |    | |  | | (_) | (_| |  __/ |  | | | | | |__|_   _|_   _|
+    //  \___/|____/ \___/|_| \_| |_|  \___/|_|    |_|  |_|\___/ \__,_|\___|_|  |_| |_|  \____||_|   |_|  
+
+    bench.add("nlohmann_json", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        nlohmann::json json = nlohmann::json::parse(addressbookJson.begin(), addressbookJson.end());
+        if (!json.is_array()) {
+            return chsum;
+        }
+        for (const auto& it : json) {
+            if (!it.is_object()) {
+                continue;
+            }
+            const auto itName = it.find("name");
+            if (itName != it.end() && itName->is_string()) {
+                chsum += itName->get<std::string_view>().size();
+            }
+            const auto itId = it.find("id");
+            if (itId != it.end() && itId->is_number()) {
+                chsum += itId->get<double>();
+            }
+            const auto itEmail = it.find("email");
+            if (itEmail != it.end() && itEmail->is_string()) {
+                chsum += itEmail->get<std::string_view>().size();
+            }
+            const auto itPhones = it.find("phones");
+            if (itPhones != it.end() && itPhones->is_array()) {
+                for (const auto& itPhone : itPhones.value()) {
+                    if (!itPhone.is_object()) {
+                        continue;
+                    }
+                    const auto itNumber = itPhone.find("number");
+                    if (itNumber != itPhone.end() && itNumber->is_string()) {
+                        chsum += itNumber->get<std::string_view>().size();
+                    }
+                    const auto itType = itPhone.find("type");
+                    if (itType != itPhone.end() && itType->is_string()) {
+                        chsum += itType->get<std::string_view>().size();
+                    }
+                }
+            }
+            const auto itEmployment = it.find("employment");
+            if (itEmployment != it.end() && itEmployment->is_object()) {
+                const auto itVariant = itEmployment->find("variant");
+                if (itVariant != itEmployment->end() && itVariant->is_string()) {
+                    chsum += itVariant->get<std::string_view>().size();
+                }
+                const auto itText = itEmployment->find("text");
+                if (itText != itEmployment->end() && itText->is_string()) {
+                    chsum += itText->get<std::string_view>().size();
+                }
+            }
+        }
+        return chsum;
+    });
+
+    // =========================================================================
+
+    nlohmann::json json_nl;
+    bench.add("nlohmann_json", 1, [&](uint32_t) -> uint32_t {
+        json_nl.clear();
+        for (const auto& person : addressbookData) {
+            nlohmann::json personObj;
+            personObj["name"] = person.name;
+            personObj["id"] = person.id;
+            personObj["email"] = person.email;
+            auto& phones = personObj["phones"];
+            for (const auto& phone : person.phones) {
+                nlohmann::json phoneObj;
+                phoneObj["number"] = phone.number;
+                phoneObj["type"] = phone.type;
+                phones.push_back(std::move(phoneObj));
+            }
+            personObj["employment"]["variant"] = person.employment.variant;
+            if (!person.employment.text.empty()) {
+                personObj["employment"]["text"] = person.employment.text;
+            }
+            json_nl.push_back(std::move(personObj));
+        }
+        return json_nl.dump(2).size();
+    });
+
+    // =========================================================================
+    //  ____             _     _     _ ____   ___  _   _ 
+    // |  _ \ __ _ _ __ (_) __| |   | / ___| / _ \| \ | |
+    // | |_) / _` | '_ \| |/ _` |_  | \___ \| | | |  \| |
+    // |  _ < (_| | |_) | | (_| | |_| |___) | |_| | |\  |
+    // |_| \_\__,_| .__/|_|\__,_|\___/|____/ \___/|_| \_|
+    //            |_|                                    
+
+    bench.add("rapidjson", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
         rapidjson::Document json;
         json.Parse(addressbookJson.data(), addressbookJson.size());
         if (!json.IsArray()) {
@@ -787,10 +2199,12 @@ void benchmark() {
     // | |__|_   _|_   _| | |_| |___) | |_| | |\  |  \ V  V /| | |_| | | | (_) | |_| | |_  | |_| | |_| | |  | |
     //  \____||_|   |_|    \___/|____/ \___/|_| \_|   \_/\_/ |_|\__|_| |_|\___/ \__,_|\__| |____/ \___/|_|  |_|
 
-    bench.add("cpp_json_without_dom", 0, [&](uint32_t) -> uint32_t {
+    // `json` is a json_reader or another basic_json_reader policy.
+    const auto readAddressbook = [](const std::string_view input, const bool structuralIndex,
+            auto&& json) -> uint32_t {
         uint32_t chsum = 0;
-        json_reader json;
-        json = addressbookJson;
+        json.structuralIndex = structuralIndex;
+        json = input;
         if (!json.is_array()) {
             return chsum;
         }
@@ -872,11 +2286,303 @@ void benchmark() {
                 default:
                     break;
                 }
-            });
-        });
-        assert(json.error == nullptr);
+            });
+        });
+        assert(json.error == nullptr);
+        return chsum;
+    };
+    bench.add("cpp_json_without_dom", 0, [&](uint32_t) -> uint32_t {
+        return readAddressbook(addressbookJson, false, json_reader());
+    });
+    bench.add("cpp_json_without_dom json_strict_reader", 0, [&](uint32_t) -> uint32_t {
+        return readAddressbook(addressbookJson, false, json_strict_reader());
+    });
+
+    // =========================================================================
+
+    using object_handler_t = std::function<void(json_reader::key_t, const json_reader::value_t&)>;
+    using array_handler_t = std::function<void(uint32_t, const json_reader::value_t&)>;
+    bench.add("cpp_json_without_dom std::function", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        json = addressbookJson;
+        if (!json.is_array()) {
+            return chsum;
+        }
+        json.parse(array_handler_t([&](uint32_t index, const json_reader::value_t& value) {
+            if (!value.is_object()) {
+                return;
+            }
+            json.parse(object_handler_t([&](json_reader::key_t key, const json_reader::value_t& value) {
+                switch_str(key, "name", "id", "email", "phones", "employment") {
+                case_str("name"):
+                    if (!value.is_string()) {
+                        return;
+                    }
+                    chsum += value.as_string().size();
+                    break;
+                case_str("id"):
+                    if (!value.is_number()) {
+                        return;
+                    }
+                    chsum += value.as_number();
+                    break;
+                case_str("email"):
+                    if (!value.is_string()) {
+                        return;
+                    }
+                    chsum += value.as_string().size();
+                    break;
+                case_str("phones"):
+                    if (!value.is_array()) {
+                        return;
+                    }
+                    json.parse(array_handler_t([&](uint32_t index, const json_reader::value_t& value) {
+                        if (!value.is_object()) {
+                            return;
+                        }
+                        json.parse(object_handler_t([&](json_reader::key_t key, const json_reader::value_t& value) {
+                            switch_str(key, "number", "type") {
+                            case_str("number"):
+                                if (!value.is_string()) {
+                                    return;
+                                }
+                                chsum += value.as_string().size();
+                                break;
+                            case_str("type"):
+                                if (!value.is_string()) {
+                                    return;
+                                }
+                                chsum += value.as_string().size();
+                                break;
+                            default:
+                                break;
+                            }
+                        }));
+                    }));
+                    break;
+                case_str("employment"):
+                    if (!value.is_object()) {
+                        return;
+                    }
+                    json.parse(object_handler_t([&](json_reader::key_t key, const json_reader::value_t& value) {
+                        switch_str(key, "variant", "text") {
+                        case_str("variant"):
+                            if (!value.is_string()) {
+                                return;
+                            }
+                            chsum += value.as_string().size();
+                            break;
+                        case_str("text"):
+                            if (!value.is_string()) {
+                                return;
+                            }
+                            chsum += value.as_string().size();
+                            break;
+                        default:
+                            break;
+                        }
+                    }));
+                    break;
+                default:
+                    break;
+                }
+            }));
+        }));
+        assert(json.error == nullptr);
+        return chsum;
+    });
+
+    bench.add("cpp_json_without_dom json_cursor", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        json_cursor json;
+        json = addressbookJson;
+        json_reader::key_t key;
+        json_reader::value_t value;
+        if (!json.next_value(value) || !value.is_array() || !json.enter()) {
+            return chsum;
+        }
+        while (json.next_value(value)) {
+            if (!value.is_object()) {
+                continue;
+            }
+            json.enter();
+            while (json.next_key(key) && json.next_value(value)) {
+                switch_str(key, "name", "id", "email", "phones", "employment") {
+                case_str("name"):
+                    if (value.is_string()) {
+                        chsum += value.as_string().size();
+                    }
+                    break;
+                case_str("id"):
+                    if (value.is_number()) {
+                        chsum += value.as_number();
+                    }
+                    break;
+                case_str("email"):
+                    if (value.is_string()) {
+                        chsum += value.as_string().size();
+                    }
+                    break;
+                case_str("phones"):
+                    if (!value.is_array()) {
+                        break;
+                    }
+                    json.enter();
+                    while (json.next_value(value)) {
+                        if (!value.is_object()) {
+                            continue;
+                        }
+                        json.enter();
+                        while (json.next_key(key) && json.next_value(value)) {
+                            switch_str(key, "number", "type") {
+                            case_str("number"):
+                            case_str("type"):
+                                if (value.is_string()) {
+                                    chsum += value.as_string().size();
+                                }
+                                break;
+                            default:
+                                break;
+                            }
+                        }
+                    }
+                    break;
+                case_str("employment"):
+                    if (!value.is_object()) {
+                        break;
+                    }
+                    json.enter();
+                    while (json.next_key(key) && json.next_value(value)) {
+                        switch_str(key, "variant", "text") {
+                        case_str("variant"):
+                        case_str("text"):
+                            if (value.is_string()) {
+                                chsum += value.as_string().size();
+                            }
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+        assert(json.error == nullptr);
+        return chsum;
+    });
+    bench.add("cpp_json_without_dom json_keys", 0, [&](uint32_t) -> uint32_t {
+        enum { name, id, email, phones, employment };
+        static constexpr json_keys<5> personKeys("name", "id", "email", "phones", "employment");
+        static constexpr json_keys<2> phoneKeys("number", "type");
+        static constexpr json_keys<2> employmentKeys("variant", "text");
+        uint32_t chsum = 0;
+        json_reader json;
+        json = addressbookJson;
+        if (!json.is_array()) {
+            return chsum;
+        }
+        const auto addString = [&](uint32_t, const json_reader::value_t& value) {
+            if (value.is_string()) {
+                chsum += value.as_string().size();
+            }
+        };
+        json.parse([&](uint32_t index, const json_reader::value_t& value) {
+            if (!value.is_object()) {
+                return;
+            }
+            json.parse(personKeys, [&](uint32_t key, const json_reader::value_t& value) {
+                switch (key) {
+                case name:
+                case email:
+                    addString(key, value);
+                    break;
+                case id:
+                    if (value.is_number()) {
+                        chsum += value.as_number();
+                    }
+                    break;
+                case phones:
+                    if (!value.is_array()) {
+                        return;
+                    }
+                    json.parse([&](uint32_t index, const json_reader::value_t& value) {
+                        if (value.is_object()) {
+                            json.parse(phoneKeys, addString);
+                        }
+                    });
+                    break;
+                case employment:
+                    if (value.is_object()) {
+                        json.parse(employmentKeys, addString);
+                    }
+                    break;
+                default:
+                    break;
+                }
+            });
+        });
+        assert(json.error == nullptr);
+        return chsum;
+    });
+#if defined(CJWD_COROUTINES)
+    bench.add("cpp_json_without_dom json_events", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        uint32_t depth = 0;
+        json_event_generator events = json_events(addressbookJson);
+        for (const json_event& event : events) {
+            switch (event.type) {
+            case json_event::types::begin_object:
+            case json_event::types::begin_array:
+                ++depth;
+                break;
+            case json_event::types::end_object:
+            case json_event::types::end_array:
+                --depth;
+                break;
+            case json_event::types::value:
+                if (depth == 2) {
+                    switch_str(event.key, "name", "id", "email") {
+                    case_str("name"):
+                    case_str("email"):
+                        if (event.value.is_string()) {
+                            chsum += event.value.as_string().size();
+                        }
+                        break;
+                    case_str("id"):
+                        if (event.value.is_number()) {
+                            chsum += event.value.as_number();
+                        }
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                else if (event.value.is_string() && ((depth == 3) | (depth == 4))) {
+                    // phones[*].number/type and employment.variant/text
+                    switch_str(event.key, "number", "type", "variant", "text") {
+                    case_str("number"):
+                    case_str("type"):
+                    case_str("variant"):
+                    case_str("text"):
+                        chsum += event.value.as_string().size();
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        assert(events.error() == nullptr);
         return chsum;
     });
+#endif
 
     // =========================================================================
 
@@ -912,7 +2618,549 @@ void benchmark() {
 
     // =========================================================================
 
+    using object_writer_t = std::function<void(json_writer::object_t)>;
+    using array_writer_t = std::function<void(json_writer::array_t)>;
+    bench.add("cpp_json_without_dom std::function", 1, [&](uint32_t) -> uint32_t {
+        json_wd.array(array_writer_t([&](json_writer::array_t json) {
+        for (const auto& person : addressbookData) {
+            json
+            .object(object_writer_t([&](json_writer::object_t json) {
+                json
+                .key("name").value(person.name)
+                .key("id").value(person.id)
+                .key("email").value(person.email)
+                .key("phones").array(array_writer_t([&](json_writer::array_t json) {
+                for (const auto& phone : person.phones) {
+                    json.
+                    object(object_writer_t([&](json_writer::object_t json) {
+                        json
+                        .key("number").value(phone.number)
+                        .key("type").value(phone.type);
+                    }));
+                }}))
+                .key("employment").object(object_writer_t([&](json_writer::object_t json) {
+                    json.key("variant").value(person.employment.variant);
+                    if (!person.employment.text.empty()) {
+                        json.key("text").value(person.employment.text);
+                    }
+                }));
+            }));
+        }}));
+        return json_wd.buffer.size();
+    });
+
+    // =========================================================================
+
     bench.run();
+
+    std::string addressbookPretty;
+    {
+        json_writer writer;
+        writer.tabSize = 4;
+        writer.array([&](json_writer::array_t json) {
+        for (const auto& person : addressbookData) {
+            json
+            .object([&](json_writer::object_t json) {
+                json
+                .key("name").value(person.name)
+                .key("id").value(person.id)
+                .key("email").value(person.email)
+                .key("phones").array([&](json_writer::array_t json) {
+                for (const auto& phone : person.phones) {
+                    json
+                    .object([&](json_writer::object_t json) {
+                        json
+                        .key("number").value(phone.number)
+                        .key("type").value(phone.type);
+                    });
+                }})
+                .key("ignore").object([&](json_writer::object_t json) {
+                    json.key("ignore").value(nullptr);
+                })
+                .key("employment").object([&](json_writer::object_t json) {
+                    json.key("variant").value(person.employment.variant);
+                    if (!person.employment.text.empty()) {
+                        json.key("text").value(person.employment.text);
+                    }
+                });
+            });
+        }});
+        addressbookPretty = std::move(writer.buffer);
+    }
+    const std::string addressbookMinified = minify(addressbookPretty);
+
+    std::string stringsJson;
+    {
+        std::string blob;
+        for (uint32_t i = 0; i < 1024; ++i) {
+            blob.push_back("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[(i * 7) % 64]);
+        }
+        json_writer writer;
+        writer.array([&](json_writer::array_t json) {
+            for (uint32_t i = 0; i < 16; ++i) {
+                json.object([&](json_writer::object_t json) {
+                    json
+                    .key("blob").value(blob)
+                    .key("message").value("GET /index.html \"200\" took 12 ms, client: \"curl/8.0\"");
+                });
+            }
+        });
+        stringsJson = std::move(writer.buffer);
+    }
+    std::string skippedJson;
+    {
+        json_writer writer;
+        writer.array([&](json_writer::array_t json) {
+            for (uint32_t i = 0; i < 16; ++i) {
+                json.object([&](json_writer::object_t json) {
+                    json
+                    .key("id").value(i)
+                    .key("payload").array([&](json_writer::array_t json) {
+                        for (uint32_t j = 0; j < 8; ++j) {
+                            json.object([&](json_writer::object_t json) {
+                                json
+                                .key("name").value("sensor \"north\" [main]")
+                                .key("values").array([&](json_writer::array_t json) {
+                                    for (uint32_t k = 0; k < 8; ++k) {
+                                        json.value(k * 0.5);
+                                    }
+                                }, json_writer::flags::single_line);
+                            });
+                        }
+                    });
+                });
+            }
+        });
+        skippedJson = std::move(writer.buffer);
+    }
+    std::string numbersJson;
+    {
+        json_writer writer;
+        writer.array([&](json_writer::array_t json) {
+            for (uint32_t i = 0; i < 256; ++i) {
+                json.object([&](json_writer::object_t json) {
+                    json
+                    .key("id").value(1000000 + i)
+                    .key("lat").value(55.7558 + i * 0.000123)
+                    .key("lon").value(37.6173 - i * 0.000321)
+                    .key("alt").value(144.25 + i * 0.5);
+                }, json_writer::flags::single_line);
+            }
+        });
+        numbersJson = std::move(writer.buffer);
+    }
+    std::string coordinatesJson;
+    {
+        json_writer writer;
+        writer.array([&](json_writer::array_t json) {
+            for (uint32_t i = 0; i < 64; ++i) {
+                json.array([&](json_writer::array_t json) {
+                    for (uint32_t j = 0; j < 64; ++j) {
+                        json.array([&](json_writer::array_t json) {
+                            json
+                            .value(37.6173 + std::sin(i * 64.0 + j) * 0.01)
+                            .value(55.7558 + std::cos(i * 64.0 + j) * 0.01);
+                        });
+                    }
+                }, json_writer::flags::single_line);
+            }
+        });
+        coordinatesJson = std::move(writer.buffer);
+    }
+    std::string telemetryJson;
+    {
+        json_writer writer;
+        writer.array([&](json_writer::array_t json) {
+            for (uint32_t i = 0; i < 32; ++i) {
+                json.array([&](json_writer::array_t json) {
+                    for (uint32_t j = 0; j < 16; ++j) {
+                        json
+                        .value(1700000000000.0 + (i * 16 + j) * 1000)
+                        .value(static_cast<double>((i * 16 + j) * 2654435761ull % 100000000));
+                    }
+                }, json_writer::flags::single_line);
+            }
+        });
+        telemetryJson = std::move(writer.buffer);
+    }
+    std::string escapedJson;
+    {
+        json_writer writer;
+        writer.array([&](json_writer::array_t json) {
+            for (uint32_t i = 0; i < 64; ++i) {
+                json.object([&](json_writer::object_t json) {
+                    json
+                    .key("path\\to").value("C:\\Program Files\\app\\bin")
+                    .key("quote").value("she said \"hi\" and left")
+                    .key("tags").array([&](json_writer::array_t json) {
+                        json.value("a\tb").value("c\\d").value("plain");
+                    }, json_writer::flags::single_line);
+                }, json_writer::flags::single_line);
+            }
+        });
+        escapedJson = std::move(writer.buffer);
+    }
+    std::string ndjson;
+    for (uint32_t i = 0; i < 256; ++i) {
+        json_writer writer;
+        writer.object([&](json_writer::object_t json) {
+            json
+            .key("id").value(i)
+            .key("event").value(i % 3 ? "click" : "view")
+            .key("duration").value(i * 0.125);
+        }, json_writer::flags::single_line);
+        ndjson += writer.buffer;
+        ndjson += '\n';
+    }
+    Benchmark benchInputs;
+    benchInputs.setColumnsNumber(1);
+    benchInputs.add("cpp_json_without_dom pretty", 0, [&](uint32_t) -> uint32_t {
+        return readAddressbook(addressbookPretty, false, json_reader());
+    });
+    benchInputs.add("cpp_json_without_dom pretty, structural index", 0, [&](uint32_t) -> uint32_t {
+        return readAddressbook(addressbookPretty, true, json_reader());
+    });
+    benchInputs.add("cpp_json_without_dom minified", 0, [&](uint32_t) -> uint32_t {
+        return readAddressbook(addressbookMinified, false, json_reader());
+    });
+    benchInputs.add("cpp_json_without_dom minified, json_strict_reader", 0, [&](uint32_t) -> uint32_t {
+        return readAddressbook(addressbookMinified, false, json_strict_reader());
+    });
+    benchInputs.add("cpp_json_without_dom minified, structural index", 0, [&](uint32_t) -> uint32_t {
+        return readAddressbook(addressbookMinified, true, json_reader());
+    });
+    const auto readLongStrings = [&](const bool structuralIndex) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        json.structuralIndex = structuralIndex;
+        json = stringsJson;
+        json.parse([&](uint32_t index, const json_reader::value_t& value) {
+            json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                chsum += value.as_string().size();
+            });
+        });
+        assert(json.error == nullptr);
+        return chsum;
+    };
+    benchInputs.add("cpp_json_without_dom long strings", 0, [&](uint32_t) -> uint32_t {
+        return readLongStrings(false);
+    });
+    benchInputs.add("cpp_json_without_dom long strings, structural index", 0, [&](uint32_t) -> uint32_t {
+        return readLongStrings(true);
+    });
+    benchInputs.add("cpp_json_without_dom mostly skipped", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        json = skippedJson;
+        json.parse([&](uint32_t index, const json_reader::value_t& value) {
+            json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if (key == "id") {
+                    chsum += value.as_number();
+                }
+            });
+        });
+        assert(json.error == nullptr);
+        return chsum;
+    });
+    const json_paths idPaths = { "/*/id" };
+    benchInputs.add("cpp_json_without_dom mostly skipped, json_paths", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        json = skippedJson;
+        json.parse(idPaths, [&](uint32_t, const json_reader::value_t& value) {
+            chsum += value.as_number();
+        });
+        assert(json.error == nullptr);
+        return chsum;
+    });
+    const auto readFirstId = [&](const bool isStop) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        json = skippedJson;
+        json.parse([&](uint32_t index, const json_reader::value_t& value) {
+            json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if ((index == 0) & (key == "id")) {
+                    chsum += value.as_number() + 1;
+                    if (isStop) {
+                        json.stop();
+                    }
+                }
+            });
+        });
+        assert(json.error == nullptr);
+        return chsum;
+    };
+    benchInputs.add("cpp_json_without_dom mostly skipped, first id", 0, [&](uint32_t) -> uint32_t {
+        return readFirstId(false);
+    });
+    benchInputs.add("cpp_json_without_dom mostly skipped, first id, stop", 0, [&](uint32_t) -> uint32_t {
+        return readFirstId(true);
+    });
+    const auto readIds = [&](const bool lazyNumbers) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        json = numbersJson;
+        json.lazyNumbers = lazyNumbers;
+        json.parse([&](uint32_t index, const json_reader::value_t& value) {
+            json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if (key == "id") {
+                    chsum += value.as_uint64();
+                }
+            });
+        });
+        assert(json.error == nullptr);
+        return chsum;
+    };
+    benchInputs.add("cpp_json_without_dom numbers, ids, 1460 B chunks", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        json_push_reader json;
+        json.parse([&](uint32_t index, const json_reader::value_t& value) {
+            json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if (key == "id") {
+                    chsum += value.as_uint64();
+                }
+            });
+        });
+        for (size_t i = 0; i < numbersJson.size(); i += 1460) {
+            json.push(std::string_view(numbersJson).substr(i, 1460));
+        }
+        json.finish();
+        assert(json.error == nullptr);
+        return chsum;
+    });
+    benchInputs.add("cpp_json_without_dom numbers, ids", 0, [&](uint32_t) -> uint32_t {
+        return readIds(false);
+    });
+    benchInputs.add("cpp_json_without_dom numbers, ids, lazy", 0, [&](uint32_t) -> uint32_t {
+        return readIds(true);
+    });
+    benchInputs.add("cpp_json_without_dom coordinates", 0, [&](uint32_t) -> uint32_t {
+        double sum = 0.0;
+        json_reader json;
+        json = coordinatesJson;
+        json.parse([&](uint32_t, const json_reader::value_t&) {
+            json.parse([&](uint32_t, const json_reader::value_t&) {
+                json.parse([&](uint32_t, const json_reader::value_t& value) {
+                    sum += value.as_number();
+                });
+            });
+        });
+        assert(json.error == nullptr);
+        return static_cast<uint32_t>(sum);
+    });
+    const auto readTelemetry = [&](auto&& json) -> uint32_t {
+        uint64_t chsum = 0;
+        json = telemetryJson;
+        json.parse([&](uint32_t, const json_reader::value_t&) {
+            json.parse([&](uint32_t, const json_reader::value_t& value) {
+                chsum += value.as_uint64();
+            });
+        });
+        assert(json.error == nullptr);
+        return static_cast<uint32_t>(chsum);
+    };
+    benchInputs.add("cpp_json_without_dom telemetry", 0, [&](uint32_t) -> uint32_t {
+        return readTelemetry(json_reader());
+    });
+    benchInputs.add("cpp_json_without_dom telemetry, json_strict_reader", 0, [&](uint32_t) -> uint32_t {
+        return readTelemetry(json_strict_reader());
+    });
+    std::string escapedMutable;
+    const auto readEscaped = [&](const bool inPlace) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        if (inPlace) {
+            escapedMutable = escapedJson; // the copy is a part of the measurement
+            json.assign_mutable(&escapedMutable[0], escapedMutable.size());
+        }
+        else {
+            json = escapedJson;
+        }
+        json.parse([&](uint32_t, const json_reader::value_t&) {
+            json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                chsum += key.size();
+                if (value.is_array()) {
+                    json.parse([&](uint32_t, const json_reader::value_t& value) {
+                        chsum += value.as_string().size();
+                    });
+                }
+                else {
+                    chsum += value.as_string().size();
+                }
+            });
+        });
+        assert(json.error == nullptr);
+        return chsum;
+    };
+    benchInputs.add("cpp_json_without_dom escaped strings", 0, [&](uint32_t) -> uint32_t {
+        return readEscaped(false);
+    });
+    benchInputs.add("cpp_json_without_dom escaped strings, in place", 0, [&](uint32_t) -> uint32_t {
+        return readEscaped(true);
+    });
+    benchInputs.add("cpp_json_without_dom ndjson, split by lines", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        for (size_t begin = 0; begin < ndjson.size();) {
+            size_t end = ndjson.find('\n', begin);
+            end = end == std::string::npos ? ndjson.size() : end;
+            json = std::string_view(ndjson).substr(begin, end - begin);
+            json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if (key == "id") {
+                    chsum += value.as_uint64();
+                }
+            });
+            begin = end + 1;
+        }
+        return chsum;
+    });
+    benchInputs.add("cpp_json_without_dom ndjson, next_document", 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        json = ndjson;
+        do {
+            json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                if (key == "id") {
+                    chsum += value.as_uint64();
+                }
+            });
+        } while (json.next_document());
+        return chsum;
+    });
+    benchInputs.run();
+
+    struct branches_input_t {
+        const char* name;
+        std::string_view input;
+        std::function<void()> read;
+    };
+    const branches_input_t branchesInputs[] = {
+        { "pretty", addressbookPretty, [&] { readAddressbook(addressbookPretty, false, json_reader()); } },
+        { "minified", addressbookMinified, [&] { readAddressbook(addressbookMinified, false, json_reader()); } },
+        { "numbers, ids", numbersJson, [&] { readIds(false); } },
+        { "telemetry", telemetryJson, [&] { readTelemetry(json_reader()); } },
+        { "mostly skipped", skippedJson, [&] { readFirstId(false); } },
+    };
+    branch_counters counters;
+    std::cout << "Branch mispredictions of json_reader:" << std::endl;
+    for (const branches_input_t& input : branchesInputs) {
+        std::cout << "  " << std::setw(16) << std::left << input.name;
+        if (!counters.is_available()) {
+            std::cout << "unavailable" << std::endl;
+            continue;
+        }
+        constexpr uint32_t iterations = 64;
+        input.read(); // warm-up
+        const std::pair<uint64_t, uint64_t> counted = counters.measure([&] {
+            for (uint32_t i = 0; i < iterations; ++i) {
+                input.read();
+            }
+        });
+        const double kilobytes = iterations * input.input.size() / 1024.0;
+        std::cout << std::fixed << std::setprecision(1)
+            << std::setw(8) << std::right << counted.second / kilobytes << " per KiB, "
+            << std::setw(5) << 100.0 * counted.second / std::max<uint64_t>(counted.first, 1)
+            << "% of branches" << std::endl;
+    }
+    std::cout << std::defaultfloat;
+
+    std::string bigNdjson;
+    for (uint32_t i = 0; i < 65536; ++i) {
+        json_writer writer;
+        writer.object([&](json_writer::object_t json) {
+            json
+            .key("id").value(i)
+            .key("event").value(i % 3 ? "click" : "view")
+            .key("duration").value(i * 0.125)
+            .key("path").value("/api/v1/items/" + std::to_string(i % 977));
+        }, json_writer::flags::single_line);
+        bigNdjson += writer.buffer;
+        bigNdjson += '\n';
+    }
+    Benchmark benchThreads;
+    benchThreads.setColumnsNumber(1);
+    const uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+    std::vector<std::string> names;
+    names.reserve(threadCounts.size() * 2 + 1); // the benchmark keeps the pointers
+    for (const uint32_t threads : threadCounts) {
+        names.push_back("cpp_json_without_dom ndjson, " + std::to_string(bigNdjson.size() >> 20)
+            + " MiB, " + std::to_string(threads) + " threads");
+        benchThreads.add(names.back().c_str(), 0, [&, threads](uint32_t) -> uint32_t {
+            std::atomic<uint32_t> chsum(0);
+            json_parallel_reader parallel;
+            parallel.threads = threads;
+            parallel.chunkSize = 256 << 10;
+            parallel.parse_lines(bigNdjson, [&](uint64_t, json_reader& reader) {
+                reader.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+                    if (key == "id") {
+                        chsum += static_cast<uint32_t>(value.as_uint64());
+                    }
+                });
+            });
+            return chsum;
+        });
+    }
+
+    std::string bigAddressbook = "[";
+    for (uint32_t i = 0; i < 16384; ++i) {
+        bigAddressbook.append(addressbookMinified, 1, addressbookMinified.size() - 2);
+        bigAddressbook += i + 1 < 16384 ? "," : "]";
+    }
+    const auto readPerson = [](json_reader& json) -> uint32_t {
+        uint32_t chsum = 0;
+        json.parse([&](json_reader::key_t key, const json_reader::value_t& value) {
+            if (value.is_string()) {
+                chsum += value.as_string().size();
+            }
+            else if (value.is_number()) {
+                chsum += value.as_number();
+            }
+            else if (key == "phones") {
+                json.parse([&](uint32_t, const json_reader::value_t&) {
+                    json.parse([&](json_reader::key_t, const json_reader::value_t& value) {
+                        chsum += value.as_string().size();
+                    });
+                });
+            }
+            else if (key == "employment") {
+                json.parse([&](json_reader::key_t, const json_reader::value_t& value) {
+                    chsum += value.as_string().size();
+                });
+            }
+        });
+        return chsum;
+    };
+    names.push_back("cpp_json_without_dom addressbook, " + std::to_string(bigAddressbook.size() >> 20)
+        + " MiB, sequential");
+    benchThreads.add(names.back().c_str(), 0, [&](uint32_t) -> uint32_t {
+        uint32_t chsum = 0;
+        json_reader json;
+        json = bigAddressbook;
+        json.parse([&](uint32_t, const json_reader::value_t&) {
+            chsum += readPerson(json);
+        });
+        return chsum;
+    });
+    for (const uint32_t threads : threadCounts) {
+        names.push_back("cpp_json_without_dom addressbook, " + std::to_string(bigAddressbook.size() >> 20)
+            + " MiB, " + std::to_string(threads) + " threads");
+        benchThreads.add(names.back().c_str(), 0, [&, threads](uint32_t) -> uint32_t {
+            std::atomic<uint32_t> chsum(0);
+            json_parallel_reader parallel;
+            parallel.threads = threads;
+            parallel.chunkSize = 256 << 10;
+            parallel.parse_array(bigAddressbook, [&](uint32_t, const json_reader::value_t&, json_reader& json) {
+                chsum += readPerson(json);
+            });
+            return chsum;
+        });
+    }
+    benchThreads.run();
 }
 
 int32_t main() {